@@ -18,5 +18,7 @@
 
 #include "filters++/api.h"
 #include "filters++/configuration_selector.h"
+#include "filters++/oversampled_filter.h"
+#include "filters++/static_filter.h"
 
 #endif // FILTERS_H
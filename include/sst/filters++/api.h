@@ -19,6 +19,7 @@
 #include <vector>
 #include <cmath>
 #include <optional>
+#include <span>
 
 #include "sst/basic-blocks/simd/setup.h"
 
@@ -28,6 +29,18 @@
 namespace sst::filtersplusplus
 {
 
+/**
+ * A coefficient change for one voice at a given frame of a processBlock call, for sample
+ * accurate automation. The arguments are those of Filter::makeCoefficients.
+ */
+struct FilterEvent
+{
+    int voice{0};
+    int sampleOffset{0};
+    float cutoff{0.f}, resonance{0.f};
+    float extra{0.f}, extra2{0.f}, extra3{0.f};
+};
+
 /**
  * @brief A class representing the surge filter models with a easier-to-use api
  *
@@ -112,6 +125,14 @@ struct Filter
     void setModelConfiguration(const ModelConfig &sk) { payload.setModelConfiguration(sk); }
     ModelConfig getModelConfiguration() const { return payload.getModelConfiguration(); }
 
+    /**
+     * Choose how accurately saturating models evaluate their nonlinearities, for instance
+     * Accurate for an offline render and Standard for live voices. Changing it requires
+     * a call to prepareInstance.
+     */
+    void setNonlinearityQuality(NonlinearityQuality q) { payload.setNonlinearityQuality(q); }
+    NonlinearityQuality getNonlinearityQuality() const { return payload.nonlinearityQuality; }
+
     /**
      * A reasonable user facing display name for the given configuration
      */
@@ -177,9 +198,10 @@ struct Filter
     static std::vector<FilterModel> availableModels();
 
     /**
-     * For a given model, return the configurations that model supports. The list by
-     * default will be unsorted, but the sort option allows you to sort it. Note that this
-     * is an allocating API to make that vector so you dont want to use it while processing.
+     * For a given model, return the configurations that model supports, in ModelConfig order.
+     * The sort option is kept for compatibility, as the list is always sorted now. Note that
+     * this is an allocating API to make that vector so you dont want to use it while
+     * processing; modelConfigurations below is the allocation free version.
      */
     static std::vector<ModelConfig> availableModelConfigurations(FilterModel model,
                                                                  bool sort = false)
@@ -187,6 +209,15 @@ struct Filter
         return details::FilterPayload::availableModelConfigurations(model, sort);
     }
 
+    /**
+     * The configurations a model supports, sorted, as a view of a compile time table. This
+     * neither allocates nor locks, so is safe to call from the audio thread.
+     */
+    static constexpr std::span<const ModelConfig> modelConfigurations(FilterModel model)
+    {
+        return details::FilterPayload::modelConfigurations(model);
+    }
+
     /**
      * Once a filter has been set up with a model type and a configuration
      * the instance needs preparation to resolve the internal state. This function
@@ -194,6 +225,39 @@ struct Filter
      */
     [[nodiscard]] bool prepareInstance();
 
+    /**
+     * Change to the model and configuration set since the last prepareInstance without the
+     * click of a reset. The running model carries on, with its coefficients held, and the
+     * output crossfades from it to the new one over fadeSamples samples, after which it is
+     * retired. This allocates nothing, so a preset morph or an automated model change can
+     * call it between blocks on the audio thread.
+     *
+     * The new model starts from a reset state and sees makeCoefficients as usual. If the old
+     * and new models both use delay lines they would share them, so the new one simply takes
+     * over with no fade. Before the first prepareInstance, or without a provided
+     * CrossfadeState, this is just prepareInstance.
+     */
+    [[nodiscard]] bool prepareInstanceWithCrossfade(int fadeSamples);
+
+    using CrossfadeState = details::CrossfadeState;
+
+    /**
+     * The outgoing model of a crossfade runs in a second copy of the filter state. Rather
+     * than every filter carrying one, a filter which crossfades is given one here, before
+     * processing starts. The filter does not own it, and one state may be shared by filters
+     * which never fade at the same time.
+     */
+    void provideCrossfadeState(CrossfadeState *xf)
+    {
+        payload.crossfade = xf;
+        payload.fadeRemaining = 0;
+    }
+
+    /**
+     * True while the outgoing model of prepareInstanceWithCrossfade is still sounding
+     */
+    bool isCrossfading() const { return payload.fadeRemaining > 0; }
+
     /**
      * If a call to prepareInstance is required, this will return true.
      */
@@ -281,6 +345,34 @@ struct Filter
      */
     void concludeBlock();
 
+    /**
+     * Process a block of planar audio, with channel c on voice c. This manages prepareBlock and
+     * concludeBlock itself, so nSamples can be any size and blocks can straddle control blocks.
+     * Do not mix it with processSample within a control block.
+     *
+     * Coefficients set with makeCoefficients take effect at the next control block boundary
+     * and ramp across that block as usual. A voice whose coefficients are not remade keeps
+     * heading for its last target, just as if the same makeCoefficients call had been repeated.
+     *
+     * For changes between control block boundaries pass events, sorted by sampleOffset. An
+     * event on a boundary is just a makeCoefficients call for that block. One inside a block
+     * re-ramps only its voice, from where it is to the new target by the end of the block,
+     * and leaves the other voices alone. Without events the loop is unchanged.
+     *
+     * @param in nChannels pointers to nSamples floats
+     * @param out nChannels pointers to nSamples floats, which may be the same as in
+     * @param nChannels 1 to 4
+     * @param events coefficient changes with sampleOffset in [0, nSamples), in order
+     */
+    void processBlock(const float *const *in, float **out, int nChannels, int nSamples,
+                      std::span<const FilterEvent> events = {});
+
+    /**
+     * As processBlock but for interleaved buffers of nSamples frames of nChannels
+     */
+    void processInterleavedBlock(const float *in, float *out, int nChannels, int nSamples,
+                                 std::span<const FilterEvent> events = {});
+
     /**
      * convenience functions for mono channel if you dont want to manage simd
      */
@@ -316,13 +408,59 @@ struct Filter
      * This API connects us to the legacy enum types for a given model
      */
     using legacyType_t = std::pair<sst::filters::FilterType, sst::filters::FilterSubType>;
-    static std::optional<legacyType_t> getLegacyTypeFor(const FilterModel &m, const ModelConfig &c)
+    static constexpr std::optional<legacyType_t> getLegacyTypeFor(const FilterModel &m,
+                                                                  const ModelConfig &c)
     {
         return details::FilterPayload::resolveLegacyTypeFor(m, c);
     }
 
+    /**
+     * What a model and configuration use of the filter state, whether they are nonlinear and
+     * roughly what they cost to run. Voice allocators can use the cost class to budget CPU
+     * before they pick a model.
+     */
+    static constexpr std::optional<sst::filters::FilterUnitTraits>
+    getFilterUnitTraitsFor(const FilterModel &m, const ModelConfig &c)
+    {
+        auto lt = getLegacyTypeFor(m, c);
+        if (!lt.has_value())
+            return std::nullopt;
+        return sst::filters::GetFilterUnitTraits(lt->first, lt->second);
+    }
+
+    /**
+     * The traits of the prepared instance. Before prepareInstance these are the conservative
+     * defaults, covering the whole state.
+     */
+    const sst::filters::FilterUnitTraits &getFilterUnitTraits() const { return payload.traits; }
+
   protected:
     details::FilterPayload payload;
+
+    SIMD_M128 crossfadeSample(SIMD_M128 in, SIMD_M128 incoming);
+
+    // Re-ramp one voice from its current coefficients to the event's over the given number of
+    // model samples
+    void applyEventWithin(const FilterEvent &e, size_t remainingSamples);
+
+    /*
+     * The control block loop behind processBlock. gather(i) makes the SIMD input for frame i,
+     * process runs one frame and scatter(i, v) writes the output. controlBlockSize is in frames
+     * so wrappers which run several model samples per frame can reuse this.
+     */
+    template <typename Gather, typename Process, typename Scatter>
+    void processBlockImpl(size_t controlBlockSize, int nSamples, Gather &&gather,
+                          Process &&process, Scatter &&scatter,
+                          std::span<const FilterEvent> events = {});
+
+    template <typename Process>
+    void processPlanarBlockWith(size_t controlBlockSize, Process &&process, const float *const *in,
+                                float **out, int nChannels, int nSamples,
+                                std::span<const FilterEvent> events = {});
+    template <typename Process>
+    void processInterleavedBlockWith(size_t controlBlockSize, Process &&process, const float *in,
+                                     float *out, int nChannels, int nSamples,
+                                     std::span<const FilterEvent> events = {});
 };
 } // namespace sst::filtersplusplus
 
@@ -16,9 +16,12 @@
 #ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_CONFIGURATION_SELECTOR_H
 #define INCLUDE_SST_FILTERS_PLUS_PLUS_CONFIGURATION_SELECTOR_H
 
+#include <array>
+#include <span>
+#include <utility>
+#include <vector>
+
 #include "api.h"
-#include <set>
-#include <map>
 
 /**
  * configuration_selector contains a set of useful functions to genreate uis
@@ -31,25 +34,52 @@
  *
  * You could make a different choice of course! Its just tweaking the presented
  * API. The internal stuff in the impl/details is just all vararg packs anyway
+ *
+ * The per model value lists are built at compile time, and every query here has a
+ * non allocating form (the span and ConfigValueList returning ones) so a preset load on the
+ * audio thread can use them. The std::vector versions are conveniences built on those.
  */
 namespace sst::filtersplusplus
 {
 
+/**
+ * A small fixed capacity list, so the partial config queries can return their results
+ * without allocating. It is big enough for every value of any one configuration dimension.
+ */
+template <typename V> struct ConfigValueList
+{
+    static constexpr size_t capacity{32};
+
+    constexpr const V *begin() const { return values.data(); }
+    constexpr const V *end() const { return values.data() + count; }
+    constexpr size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+    constexpr const V &operator[](size_t i) const { return values[i]; }
+
+    constexpr void push_back(const V &v) { values[count++] = v; }
+
+    std::vector<V> toVector() const { return std::vector<V>(begin(), end()); }
+
+  private:
+    std::array<V, capacity> values{};
+    size_t count{0};
+};
+
 /**
  * A simple boolean check of if a given model config is valid for a given model
  * @param fm A given model
  * @param tc A candidate config
  */
-bool isModelConfigValid(const FilterModel &fm, const ModelConfig &tc);
+constexpr bool isModelConfigValid(const FilterModel &fm, const ModelConfig &tc);
 
 /**
  * This API allows you to build a partial config and test if you are valid
  * so far. So for a model, do you have a valid passband, passband/slope
  * and passband/slope/drive. The full quartet can be answered with isModelConfigValid
  */
-bool isPartialConfigValid(const FilterModel &fm, Passband p);
-bool isPartialConfigValid(const FilterModel &fm, Passband p, Slope s);
-bool isPartialConfigValid(const FilterModel &fm, Passband p, Slope s, DriveMode d);
+constexpr bool isPartialConfigValid(const FilterModel &fm, Passband p);
+constexpr bool isPartialConfigValid(const FilterModel &fm, Passband p, Slope s);
+constexpr bool isPartialConfigValid(const FilterModel &fm, Passband p, Slope s, DriveMode d);
 
 /**
  * isPartialMatch is just a utility where you can send a model config and
@@ -57,14 +87,14 @@ bool isPartialConfigValid(const FilterModel &fm, Passband p, Slope s, DriveMode
  */
 template <is_modelconfig_enum T, typename... Args>
     requires(is_modelconfig_enum<Args> && ...)
-bool isPartialMatch(const ModelConfig &mc, Args... cstr);
+constexpr bool isPartialMatch(const ModelConfig &mc, Args... cstr);
 
 /**
  * Given a model config, which is the 'closes' valid model to the one
  * handed in. If the model config is valid, it is just returned, otherwise
  * find partial matches up the stack dropping SM, DT, Slp, and Filt each.
  */
-ModelConfig closestValidModelTo(const FilterModel &fm, const ModelConfig &mc);
+constexpr ModelConfig closestValidModelTo(const FilterModel &fm, const ModelConfig &mc);
 
 /**
  * Given an enum type, what are the potential values this
@@ -76,14 +106,20 @@ ModelConfig closestValidModelTo(const FilterModel &fm, const ModelConfig &mc);
 template <is_modelconfig_enum T>
 std::vector<T> potentialValuesFor(const FilterModel &fm, bool returnUnsupportedIfEmpty = false);
 
+/**
+ * The same values, sorted and without UNSUPPORTED, as a view of a compile time table.
+ */
+template <is_modelconfig_enum T>
+constexpr std::span<const T> supportedValuesFor(const FilterModel &fm);
+
 /**
  * If a model doesn't use a particular dimension at all
  * (namely all values of that dimension are UNSUPPORTED)
  * return true.
  */
-template <is_modelconfig_enum T> inline bool supportsChoice(const FilterModel &fm)
+template <is_modelconfig_enum T> constexpr bool supportsChoice(const FilterModel &fm)
 {
-    return !potentialValuesFor<T>(fm).empty();
+    return !supportedValuesFor<T>(fm).empty();
 }
 
 /**
@@ -132,12 +168,24 @@ template <is_modelconfig_enum T, typename... Args>
     requires(is_distinct_modelconfig_enum<Args, T> && ...)
 std::vector<T> valuesForPartialConfig(const FilterModel &fm, Args... args);
 
+/**
+ * The allocation free forms of valuesAndValidityForPartiaulConfig and valuesForPartialConfig,
+ * with the constraining values in any order.
+ */
+template <is_modelconfig_enum T, typename... Args>
+    requires(is_distinct_modelconfig_enum<Args, T> && ...)
+constexpr ConfigValueList<std::pair<T, bool>> partialConfigValuesAndValidity(const FilterModel &fm,
+                                                                             Args... args);
+template <is_modelconfig_enum T, typename... Args>
+    requires(is_distinct_modelconfig_enum<Args, T> && ...)
+constexpr ConfigValueList<T> partialConfigValues(const FilterModel &fm, Args... args);
+
 /*
  * This is a utility telling if there's either no values or just unsupported valid
  */
 template <is_modelconfig_enum T, typename... Args>
     requires(is_distinct_modelconfig_enum<Args, T> && ...)
-bool noChoicesOrOnlyUnsupported(const FilterModel &fm, Args... args);
+constexpr bool noChoicesOrOnlyUnsupported(const FilterModel &fm, Args... args);
 
 } // namespace sst::filtersplusplus
 
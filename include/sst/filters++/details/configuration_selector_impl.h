@@ -16,63 +16,86 @@
 #ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_CONFIGURATION_SELECTOR_IMPL_H
 #define INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_CONFIGURATION_SELECTOR_IMPL_H
 
+#include <algorithm>
+#include <cstdint>
+
 #include "../api.h"
 
 namespace sst::filtersplusplus
 {
-inline bool isModelConfigValid(const sst::filtersplusplus::FilterModel &fm,
-                               const sst::filtersplusplus::ModelConfig &tc)
+namespace details
 {
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    for (auto &c : cf)
-        if (c == tc)
-            return true;
-
-    return false;
+/*
+ * The configurations are sorted by (pt, st, dt, mt), so the ones sharing a leading run of
+ * those are contiguous and a binary search on just that run finds them.
+ */
+template <int depth>
+constexpr bool hasConfigWithPrefix(const FilterModel &fm, const ModelConfig &key)
+{
+    auto less = [](const ModelConfig &a, const ModelConfig &b) {
+        if (a.pt != b.pt)
+            return a.pt < b.pt;
+        if (depth > 1 && a.st != b.st)
+            return a.st < b.st;
+        if (depth > 2 && a.dt != b.dt)
+            return a.dt < b.dt;
+        return false;
+    };
+    auto cf = Filter::modelConfigurations(fm);
+    return std::binary_search(cf.begin(), cf.end(), key, less);
 }
 
-inline bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p)
-{
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    for (auto &c : cf)
+// The sorted distinct supported values of one dimension of a configuration table
+template <is_modelconfig_enum T, const auto &table>
+inline constexpr auto dimensionValues{[]() {
+    std::array<T, ConfigValueList<T>::capacity> vals{};
+    size_t n{0};
+    for (const auto &e : table)
     {
-        if (get<Passband>(c) == p)
-            return true;
+        auto v = get<T>(e.first);
+        if (v != T::UNSUPPORTED && std::find(vals.begin(), vals.begin() + n, v) == vals.begin() + n)
+            vals[n++] = v;
     }
-    return false;
+    std::sort(vals.begin(), vals.begin() + n);
+
+    ConfigValueList<T> res;
+    for (size_t i = 0; i < n; ++i)
+        res.push_back(vals[i]);
+    return res;
+}()};
+} // namespace details
+
+constexpr bool isModelConfigValid(const sst::filtersplusplus::FilterModel &fm,
+                                  const sst::filtersplusplus::ModelConfig &tc)
+{
+    return Filter::getLegacyTypeFor(fm, tc).has_value();
 }
 
-inline bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p, Slope s)
+constexpr bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p)
 {
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    for (auto &c : cf)
-    {
-        if (get<Passband>(c) == p && get<Slope>(c) == s)
-            return true;
-    }
-    return false;
+    return details::hasConfigWithPrefix<1>(fm, {p});
 }
 
-inline bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p, Slope s,
-                                 DriveMode d)
+constexpr bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p,
+                                    Slope s)
 {
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    for (auto &c : cf)
-    {
-        if (get<Passband>(c) == p && get<Slope>(c) == s && get<DriveMode>(c) == d)
-            return true;
-    }
-    return false;
+    return details::hasConfigWithPrefix<2>(fm, {p, s});
+}
+
+constexpr bool isPartialConfigValid(const sst::filtersplusplus::FilterModel &fm, Passband p,
+                                    Slope s, DriveMode d)
+{
+    return details::hasConfigWithPrefix<3>(fm, {p, s, d});
 }
 
-inline ModelConfig closestValidModelTo(const sst::filtersplusplus::FilterModel &fm,
-                                       const sst::filtersplusplus::ModelConfig &mc)
+constexpr ModelConfig closestValidModelTo(const sst::filtersplusplus::FilterModel &fm,
+                                          const sst::filtersplusplus::ModelConfig &mc)
 {
     if (isModelConfigValid(fm, mc))
         return mc;
 
     // compare all except sm, then dt, then sl, then pb, then return model 0
-    auto cf = Filter::availableModelConfigurations(fm);
+    auto cf = Filter::modelConfigurations(fm);
     for (auto &c : cf)
     {
         if (c.pt == mc.pt && c.st == mc.st && c.dt == mc.dt)
@@ -95,18 +118,45 @@ inline ModelConfig closestValidModelTo(const sst::filtersplusplus::FilterModel &
 }
 
 template <is_modelconfig_enum T>
-inline std::vector<T> potentialValuesFor(const sst::filtersplusplus::FilterModel &fm,
-                                         bool returnUnsupportedIfEmpty)
+constexpr std::span<const T> supportedValuesFor(const sst::filtersplusplus::FilterModel &fm)
 {
-    std::set<T> vals;
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    for (auto &c : cf)
+#define FILTER_MODEL_CASE(model, ns)                                                               \
+    case model:                                                                                    \
+    {                                                                                              \
+        const auto &v = details::dimensionValues<T, ns::configurations>;                           \
+        return {v.begin(), v.size()};                                                              \
+    }
+
+    switch (fm)
     {
-        auto en = get<T>(c);
-        if (en != T::UNSUPPORTED)
-            vals.insert(get<T>(c));
+        FILTER_MODEL_CASE(FilterModel::VemberLadder, models::vemberladder);
+        FILTER_MODEL_CASE(FilterModel::K35, models::k35);
+        FILTER_MODEL_CASE(FilterModel::VemberClassic, models::vemberclassic);
+        FILTER_MODEL_CASE(FilterModel::VintageLadder, models::vintageladder);
+        FILTER_MODEL_CASE(FilterModel::CutoffWarp, models::cutoffwarp);
+        FILTER_MODEL_CASE(FilterModel::ResonanceWarp, models::resonancewarp);
+        FILTER_MODEL_CASE(FilterModel::DiodeLadder, models::diodeladder);
+        FILTER_MODEL_CASE(FilterModel::OBXD_4Pole, models::obxd_4pole);
+        FILTER_MODEL_CASE(FilterModel::OBXD_2Pole, models::obxd_2pole);
+        FILTER_MODEL_CASE(FilterModel::OBXD_Xpander, models::obxd_xpander);
+        FILTER_MODEL_CASE(FilterModel::SampleAndHold, models::sampleandhold);
+        FILTER_MODEL_CASE(FilterModel::Comb, models::comb);
+        FILTER_MODEL_CASE(FilterModel::TriPole, models::tripole);
+        FILTER_MODEL_CASE(FilterModel::CytomicSVF, models::cytomicsvf);
+    default:
+        break;
     }
-    auto res = std::vector(vals.begin(), vals.end());
+#undef FILTER_MODEL_CASE
+
+    return {};
+}
+
+template <is_modelconfig_enum T>
+inline std::vector<T> potentialValuesFor(const sst::filtersplusplus::FilterModel &fm,
+                                         bool returnUnsupportedIfEmpty)
+{
+    auto vals = supportedValuesFor<T>(fm);
+    auto res = std::vector<T>(vals.begin(), vals.end());
     if (res.empty() && returnUnsupportedIfEmpty)
     {
         res.emplace_back(T::UNSUPPORTED);
@@ -116,56 +166,62 @@ inline std::vector<T> potentialValuesFor(const sst::filtersplusplus::FilterModel
 
 namespace details
 {
-inline bool mcequal(const ModelConfig &mc) { return true; }
+constexpr bool mcequal(const ModelConfig &mc) { return true; }
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_modelconfig_enum<Args> && ...)
-inline bool mcequal(const ModelConfig &mc, T val, Args... rest_args)
+constexpr bool mcequal(const ModelConfig &mc, T val, Args... rest_args)
 {
     return get<T>(mc) == val && mcequal(mc, rest_args...);
 }
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_modelconfig_enum<Args> && ...)
-inline std::vector<std::pair<T, bool>> vavpc(const FilterModel &fm, Args... cstr)
+constexpr ConfigValueList<std::pair<T, bool>> vavpc(const FilterModel &fm, Args... cstr)
 {
+    static_assert(ConfigValueList<T>::capacity <= 32, "validity is kept in a 32 bit mask");
 
-    auto cf = Filter::availableModelConfigurations(fm, true);
-    auto ac = potentialValuesFor<T>(fm);
-    std::map<T, bool> tmp;
-    for (auto c : ac)
-        tmp[c] = false;
+    auto vals = supportedValuesFor<T>(fm);
+    uint32_t validMask{0};
+    bool unsupportedMatches{false};
 
-    for (const auto &c : cf)
+    for (const auto &c : Filter::modelConfigurations(fm))
     {
-        if (mcequal(c, cstr...))
-        {
-            tmp[get<T>(c)] = true;
-        }
+        if (!mcequal(c, cstr...))
+            continue;
+
+        auto v = get<T>(c);
+        if (v == T::UNSUPPORTED)
+            unsupportedMatches = true;
+        else
+            validMask |= 1U << (std::lower_bound(vals.begin(), vals.end(), v) - vals.begin());
     }
 
-    std::vector<std::pair<T, bool>> res;
-    for (const auto &[t, b] : tmp)
-        res.emplace_back(t, b);
+    // UNSUPPORTED sorts first, and only appears if a matching configuration leaves T unset
+    ConfigValueList<std::pair<T, bool>> res;
+    if (unsupportedMatches)
+        res.push_back({T::UNSUPPORTED, true});
+    for (size_t i = 0; i < vals.size(); ++i)
+        res.push_back({vals[i], ((validMask >> i) & 1) != 0});
     return res;
 }
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_modelconfig_enum<Args> && ...)
-inline std::vector<T> vapc(const FilterModel &fm, Args... cstr)
+constexpr ConfigValueList<T> vapc(const FilterModel &fm, Args... cstr)
 {
     auto t = vavpc<T>(fm, cstr...);
-    std::vector<T> res;
+    ConfigValueList<T> res;
     for (auto &[c, b] : t)
         if (b)
-            res.emplace_back(c);
+            res.push_back(c);
     return res;
 }
 } // namespace details
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_modelconfig_enum<Args> && ...)
-inline bool isPartialMatch(const sst::filtersplusplus::ModelConfig &mc, Args... cstr)
+constexpr bool isPartialMatch(const sst::filtersplusplus::ModelConfig &mc, Args... cstr)
 {
     return details::mcequal(mc, cstr...);
 }
@@ -173,7 +229,7 @@ inline bool isPartialMatch(const sst::filtersplusplus::ModelConfig &mc, Args...
 template <is_modelconfig_enum T>
 inline std::vector<std::pair<T, bool>> valuesAndValidityForPartialConfig(const FilterModel &fm)
 {
-    auto r = potentialValuesFor<T>(fm);
+    auto r = supportedValuesFor<T>(fm);
     std::vector<std::pair<T, bool>> res;
     for (const auto &e : r)
         res.emplace_back(e, true);
@@ -185,7 +241,7 @@ inline std::vector<std::pair<T, bool>> valuesAndValidityForPartialConfig(const F
                                                                          Passband p)
 {
     static_assert(!std::is_same_v<T, Passband>);
-    return details::vavpc<T>(fm, p);
+    return details::vavpc<T>(fm, p).toVector();
 }
 
 template <is_modelconfig_enum T>
@@ -193,7 +249,7 @@ inline std::vector<std::pair<T, bool>> valuesAndValidityForPartialConfig(const F
                                                                          Passband p, Slope s)
 {
     static_assert(std::is_same_v<T, FilterSubModel> || std::is_same_v<T, DriveMode>);
-    return details::vavpc<T>(fm, p, s);
+    return details::vavpc<T>(fm, p, s).toVector();
 }
 
 template <is_modelconfig_enum T>
@@ -201,7 +257,7 @@ inline std::vector<std::pair<T, bool>>
 valuesAndValidityForPartialConfig(const FilterModel &fm, Passband p, Slope s, DriveMode d)
 {
     static_assert(std::is_same_v<T, FilterSubModel>);
-    return details::vavpc<T>(fm, p, s, d);
+    return details::vavpc<T>(fm, p, s, d).toVector();
 }
 
 template <is_modelconfig_enum T, typename... Args>
@@ -209,46 +265,61 @@ template <is_modelconfig_enum T, typename... Args>
 std::vector<std::pair<T, bool>> valuesAndValidityForPartiaulConfig(const FilterModel &fm,
                                                                    Args... args)
 {
-    return details::vavpc<T>(fm, args...);
+    return details::vavpc<T>(fm, args...).toVector();
 }
 
 template <is_modelconfig_enum T> inline std::vector<T> valuesForPartialConfig(const FilterModel &fm)
 {
-    return details::vapc<T>(fm);
+    return details::vapc<T>(fm).toVector();
 }
 
 template <is_modelconfig_enum T>
 inline std::vector<T> valuesForPartialConfig(const FilterModel &fm, const Passband &p)
 {
-    return details::vapc<T>(fm, p);
+    return details::vapc<T>(fm, p).toVector();
 }
 
 template <is_modelconfig_enum T>
 inline std::vector<T> valuesForPartialConfig(const FilterModel &fm, const Passband &p,
                                              const Slope &s)
 {
-    return details::vapc<T>(fm, p, s);
+    return details::vapc<T>(fm, p, s).toVector();
 }
 
 template <is_modelconfig_enum T>
 inline std::vector<T> valuesForPartialConfig(const FilterModel &fm, const Passband &p,
                                              const Slope &s, const DriveMode &d)
 {
-    return details::vapc<T>(fm, p, s, d);
+    return details::vapc<T>(fm, p, s, d).toVector();
 }
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_distinct_modelconfig_enum<Args, T> && ...)
 std::vector<T> valuesForPartialConfig(const FilterModel &fm, Args... args)
+{
+    return details::vapc<T>(fm, args...).toVector();
+}
+
+template <is_modelconfig_enum T, typename... Args>
+    requires(is_distinct_modelconfig_enum<Args, T> && ...)
+constexpr ConfigValueList<std::pair<T, bool>> partialConfigValuesAndValidity(const FilterModel &fm,
+                                                                             Args... args)
+{
+    return details::vavpc<T>(fm, args...);
+}
+
+template <is_modelconfig_enum T, typename... Args>
+    requires(is_distinct_modelconfig_enum<Args, T> && ...)
+constexpr ConfigValueList<T> partialConfigValues(const FilterModel &fm, Args... args)
 {
     return details::vapc<T>(fm, args...);
 }
 
 template <is_modelconfig_enum T, typename... Args>
     requires(is_distinct_modelconfig_enum<Args, T> && ...)
-bool noChoicesOrOnlyUnsupported(const FilterModel &fm, Args... args)
+constexpr bool noChoicesOrOnlyUnsupported(const FilterModel &fm, Args... args)
 {
-    auto tmp = valuesForPartialConfig<T>(fm, args...);
+    auto tmp = details::vapc<T>(fm, args...);
     if (tmp.empty())
         return true;
     if (tmp.size() == 1 && tmp[0] == T::UNSUPPORTED)
@@ -16,6 +16,7 @@
 #ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_FILTER_IMPL_H
 #define INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_FILTER_IMPL_H
 
+#include <algorithm>
 #include <cassert>
 
 namespace sst::filtersplusplus
@@ -24,6 +25,9 @@ inline SIMD_M128 offFun(sst::filters::QuadFilterUnitState *__restrict, SIMD_M128
 
 inline bool Filter::prepareInstance()
 {
+    // The previous model may have used registers the new one does not, so clear them all
+    // here. After this reset and resetVoice only touch the live ones.
+    payload.traits = {};
     reset();
     if (payload.filterModel == FilterModel::None)
     {
@@ -37,7 +41,8 @@ inline bool Filter::prepareInstance()
     if (ft == sst::filters::FilterType::fut_none)
         return false;
 
-    payload.func = GetQFPtrFilterUnit(ft, st);
+    payload.func = GetQFPtrFilterUnit(ft, st, payload.nonlinearityAccuracy());
+    payload.traits = sst::filters::GetFilterUnitTraits(ft, st);
 
     assert(requiredDelayLinesSizes(getFilterModel(), getModelConfiguration()) == 0 ||
            payload.active[0] == 0 || payload.externalDelayLines[0] != nullptr);
@@ -51,6 +56,31 @@ inline bool Filter::prepareInstance()
     return payload.func != nullptr;
 }
 
+inline bool Filter::prepareInstanceWithCrossfade(int fadeSamples)
+{
+    auto outgoing = payload.func;
+    auto outgoingTraits = payload.traits;
+    auto *xf = payload.crossfade;
+    if (!outgoing || !xf || fadeSamples <= 0)
+        return prepareInstance();
+
+    // If a fade is already running it is cut short, and what is playing now fades out
+    xf->state = payload.qfuState;
+    std::fill(xf->state.dC, &xf->state.dC[sst::filters::n_cm_coeffs], SIMD_MM(setzero_ps)());
+
+    if (!prepareInstance())
+        return false;
+
+    if (outgoingTraits.delayLineSize > 0 && payload.traits.delayLineSize > 0)
+        return true;
+
+    xf->func = outgoing;
+    xf->gain = 1.f;
+    xf->step = 1.f / fadeSamples;
+    payload.fadeRemaining = fadeSamples;
+    return true;
+}
+
 inline int Filter::coefficientsExtraCount(FilterModel model, const ModelConfig &config)
 {
     switch (model)
@@ -121,11 +151,13 @@ inline void Filter::makeCoefficients(int voice, float cutoff, float resonance, f
     }
     break;
     }
+    payload.coefficientsPending[voice] = true;
 }
 
 inline void Filter::freezeCoefficientsFor(int voice)
 {
     payload.makers[voice].FromDirect(payload.makers[voice].fromDirectLast);
+    payload.coefficientsPending[voice] = true;
 }
 
 inline void Filter::copyCoefficientsFromVoiceToVoice(int from, int to)
@@ -137,6 +169,7 @@ inline void Filter::copyCoefficientsFromVoiceToVoice(int from, int to)
         payload.makers[to].dC[i] = payload.makers[from].dC[i];
         payload.makers[to].fromDirectLast[i] = payload.makers[from].fromDirectLast[i];
     }
+    payload.coefficientsPending[to] = true;
 }
 
 inline void Filter::makeConstantCoefficients(int voice, float cutoff, float resonance, float extra,
@@ -162,13 +195,29 @@ inline void Filter::prepareBlock()
         {
             payload.makers[i].updateState(payload.qfuState, i);
         }
+        payload.coefficientsPending[i] = false;
     }
 }
 
 inline SIMD_M128 Filter::processSample(SIMD_M128 x)
 {
     assert(payload.func);
-    return payload.func(&payload.qfuState, x);
+    auto res = payload.func(&payload.qfuState, x);
+    if (payload.fadeRemaining > 0)
+        return crossfadeSample(x, res);
+    return res;
+}
+
+inline SIMD_M128 Filter::crossfadeSample(SIMD_M128 x, SIMD_M128 incoming)
+{
+    // Both models see the same input so their outputs are largely correlated, which makes a
+    // linear rather than an equal power fade the right one
+    auto *xf = payload.crossfade;
+    auto outgoing = xf->func(&xf->state, x);
+    auto g = SIMD_MM(set1_ps)(xf->gain);
+    xf->gain -= xf->step;
+    payload.fadeRemaining--;
+    return SIMD_MM(add_ps)(incoming, SIMD_MM(mul_ps)(g, SIMD_MM(sub_ps)(outgoing, incoming)));
 }
 
 inline void Filter::concludeBlock()
@@ -192,9 +241,166 @@ inline std::vector<FilterModel> Filter::availableModels()
 
 inline size_t Filter::requiredDelayLinesSizes(FilterModel model, const ModelConfig &k)
 {
-    if (model == FilterModel::Comb)
-        return sst::filters::utilities::MAX_FB_COMB + sst::filters::utilities::SincTable::FIRipol_N;
-    return 0;
+    auto traits = getFilterUnitTraitsFor(model, k);
+    return traits.has_value() ? traits->delayLineSize : 0;
+}
+
+inline void Filter::applyEventWithin(const FilterEvent &e, size_t remainingSamples)
+{
+    assert(e.voice >= 0 && e.voice < 4);
+    auto &m = payload.makers[e.voice];
+
+    // pick the lane up where the ramp has got to, aim it at the new target, and arrive there
+    // at the end of the block like any other ramp
+    m.updateCoefficients(payload.qfuState, e.voice);
+    makeCoefficients(e.voice, e.cutoff, e.resonance, e.extra, e.extra2, e.extra3);
+    auto inv = 1.f / remainingSamples;
+    for (int i = 0; i < sst::filters::n_cm_coeffs; ++i)
+        m.dC[i] = (m.tC[i] - m.C[i]) * inv;
+    m.updateState(payload.qfuState, e.voice);
+
+    // so the next block carries on to this target rather than waiting to be remade
+    payload.coefficientsPending[e.voice] = false;
+}
+
+template <typename Gather, typename Process, typename Scatter>
+inline void Filter::processBlockImpl(size_t controlBlockSize, int nSamples, Gather &&gather,
+                                     Process &&process, Scatter &&scatter,
+                                     std::span<const FilterEvent> events)
+{
+    assert(payload.func);
+    assert(controlBlockSize > 0);
+
+    int pos{0};
+    size_t nextEvent{0};
+    while (pos < nSamples)
+    {
+        if (payload.blockPos == 0)
+        {
+            // events on the block boundary are simply this block's coefficients
+            while (nextEvent < events.size() && events[nextEvent].sampleOffset <= pos)
+            {
+                const auto &e = events[nextEvent++];
+                makeCoefficients(e.voice, e.cutoff, e.resonance, e.extra, e.extra2, e.extra3);
+            }
+
+            // voices nobody has remade carry on to their last target, as if the caller had
+            // repeated the same makeCoefficients call
+            for (int v = 0; v < 4; ++v)
+            {
+                if (payload.active[v] && !payload.coefficientsPending[v])
+                    freezeCoefficientsFor(v);
+            }
+            prepareBlock();
+        }
+        else if (nextEvent < events.size() && events[nextEvent].sampleOffset <= pos)
+        {
+            // the model may run several samples per frame, as in OversampledFilter
+            auto remaining =
+                (controlBlockSize - payload.blockPos) * payload.blockSize / controlBlockSize;
+            while (nextEvent < events.size() && events[nextEvent].sampleOffset <= pos)
+                applyEventWithin(events[nextEvent++], remaining);
+        }
+
+        auto n = std::min(nSamples - pos, (int)(controlBlockSize - payload.blockPos));
+        if (nextEvent < events.size())
+            n = std::min(n, events[nextEvent].sampleOffset - pos);
+        for (int i = pos; i < pos + n; ++i)
+            scatter(i, process(gather(i)));
+
+        pos += n;
+        payload.blockPos += n;
+        if (payload.blockPos == controlBlockSize)
+        {
+            concludeBlock();
+            payload.blockPos = 0;
+        }
+    }
+}
+
+template <typename Process>
+inline void Filter::processPlanarBlockWith(size_t controlBlockSize, Process &&process,
+                                           const float *const *in, float **out, int nChannels,
+                                           int nSamples, std::span<const FilterEvent> events)
+{
+    assert(nChannels >= 1 && nChannels <= 4);
+    processBlockImpl(
+        controlBlockSize, nSamples,
+        [in, nChannels](int i) {
+            float v alignas(16)[4]{};
+            for (int c = 0; c < nChannels; ++c)
+                v[c] = in[c][i];
+            return SIMD_MM(load_ps)(v);
+        },
+        process,
+        [out, nChannels](int i, SIMD_M128 r) {
+            float v alignas(16)[4];
+            SIMD_MM(store_ps)(v, r);
+            for (int c = 0; c < nChannels; ++c)
+                out[c][i] = v[c];
+        },
+        events);
+}
+
+template <typename Process>
+inline void Filter::processInterleavedBlockWith(size_t controlBlockSize, Process &&process,
+                                                const float *in, float *out, int nChannels,
+                                                int nSamples, std::span<const FilterEvent> events)
+{
+    assert(nChannels >= 1 && nChannels <= 4);
+    processBlockImpl(
+        controlBlockSize, nSamples,
+        [in, nChannels](int i) {
+            float v alignas(16)[4]{};
+            for (int c = 0; c < nChannels; ++c)
+                v[c] = in[i * nChannels + c];
+            return SIMD_MM(load_ps)(v);
+        },
+        process,
+        [out, nChannels](int i, SIMD_M128 r) {
+            float v alignas(16)[4];
+            SIMD_MM(store_ps)(v, r);
+            for (int c = 0; c < nChannels; ++c)
+                out[i * nChannels + c] = v[c];
+        },
+        events);
+}
+
+inline void Filter::processBlock(const float *const *in, float **out, int nChannels,
+                                 int nSamples, std::span<const FilterEvent> events)
+{
+    if (payload.fadeRemaining > 0)
+    {
+        processPlanarBlockWith(
+            payload.blockSize, [this](SIMD_M128 x) { return processSample(x); }, in, out,
+            nChannels, nSamples, events);
+        return;
+    }
+
+    // hoist the model pointer so the inner loop is a direct call per frame
+    auto func = payload.func;
+    auto *state = &payload.qfuState;
+    processPlanarBlockWith(
+        payload.blockSize, [func, state](SIMD_M128 x) { return func(state, x); }, in, out,
+        nChannels, nSamples, events);
+}
+
+inline void Filter::processInterleavedBlock(const float *in, float *out, int nChannels,
+                                            int nSamples, std::span<const FilterEvent> events)
+{
+    if (payload.fadeRemaining > 0)
+    {
+        processInterleavedBlockWith(
+            payload.blockSize, [this](SIMD_M128 x) { return processSample(x); }, in, out,
+            nChannels, nSamples, events);
+        return;
+    }
+
+    auto func = payload.func;
+    auto *state = &payload.qfuState;
+    processInterleavedBlockWith(
+        payload.blockSize, [func, state](SIMD_M128 x) { return func(state, x); }, in, out,
+        nChannels, nSamples, events);
 }
 
 inline float Filter::processMonoSample(float in)
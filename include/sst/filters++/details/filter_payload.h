@@ -16,11 +16,13 @@
 #ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_FILTER_PAYLOAD_H
 #define INCLUDE_SST_FILTERS_PLUS_PLUS_DETAILS_FILTER_PAYLOAD_H
 
+#include <algorithm>
 #include <tuple>
-#include <unordered_map>
 #include <iostream>
 #include <array>
 #include <optional>
+#include <span>
+#include <type_traits>
 #include "sst/filters.h"
 
 #include "sst/filters++/enums.h"
@@ -29,6 +31,18 @@
 
 namespace sst::filtersplusplus::details
 {
+/*
+ * The outgoing unit during a crossfaded model change, running on a copy of its state with the
+ * coefficients held. This is a whole second unit state, so it lives outside the payload and
+ * only filters which crossfade provide one.
+ */
+struct CrossfadeState
+{
+    sst::filters::FilterUnitQFPtr func{nullptr};
+    sst::filters::QuadFilterUnitState state{};
+    float gain{0.f}, step{0.f};
+};
+
 struct FilterPayload
 {
     FilterPayload() { init(); }
@@ -73,6 +87,26 @@ struct FilterPayload
         return {passType, slopeLevel, driveType, subModelType};
     }
 
+    void setNonlinearityQuality(NonlinearityQuality q)
+    {
+        nonlinearityQuality = q;
+        valid = false;
+    }
+
+    sst::filters::NonlinearityAccuracy nonlinearityAccuracy() const
+    {
+        switch (nonlinearityQuality)
+        {
+        case NonlinearityQuality::Cheap:
+            return sst::filters::NonlinearityAccuracy::Cheap;
+        case NonlinearityQuality::Accurate:
+            return sst::filters::NonlinearityAccuracy::Accurate;
+        case NonlinearityQuality::Standard:
+            break;
+        }
+        return sst::filters::NonlinearityAccuracy::Standard;
+    }
+
     void setSampleRateAndBlockSize(double sampleRate, size_t blockSize)
     {
         this->sampleRate = sampleRate;
@@ -82,6 +116,7 @@ struct FilterPayload
             m.setSampleRateAndBlockSize(sampleRate, blockSize);
         qfuState.sampleRate = sampleRate;
         qfuState.sampleRateInv = sampleRateInv;
+        blockPos = 0;
     }
     bool valid{false};
 
@@ -106,16 +141,29 @@ struct FilterPayload
     Slope slopeLevel{Slope::UNSUPPORTED};
     DriveMode driveType{DriveMode::UNSUPPORTED};
     FilterSubModel subModelType{FilterSubModel::UNSUPPORTED};
+    NonlinearityQuality nonlinearityQuality{NonlinearityQuality::Standard};
 
     double sampleRate{1.}, sampleRateInv{1.};
     size_t blockSize{0};
 
+    // processBlock's position in the control block, and which voices have had coefficients
+    // set since the last prepareBlock
+    size_t blockPos{0};
+    std::array<bool, 4> coefficientsPending{};
+
     std::array<uint32_t, 4> active{0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
 
-    void init() { memset(&qfuState, 0, sizeof(qfuState)); }
+    void init()
+    {
+        memset(&qfuState, 0, sizeof(qfuState));
+        fadeRemaining = 0;
+    }
     void reset()
     {
-        std::fill(qfuState.R, &qfuState.R[sst::filters::n_filter_registers], SIMD_MM(setzero_ps)());
+        blockPos = 0;
+        fadeRemaining = 0;
+        // only the registers the unit uses; the rest are already clear from prepareInstance
+        std::fill(qfuState.R, &qfuState.R[traits.registers], SIMD_MM(setzero_ps)());
         int i{0};
         for (auto &c : makers)
         {
@@ -135,7 +183,7 @@ struct FilterPayload
         }
         auto mask = SIMD_MM(cmpeq_ps)(SIMD_MM(load_ps)(m1), SIMD_MM(load_ps)(m2));
 
-        for (int i = 0; i < sst::filters::n_filter_registers; i++)
+        for (int i = 0; i < traits.registers; i++)
         {
             qfuState.R[i] = SIMD_MM(and_ps)(qfuState.R[i], mask);
         }
@@ -146,24 +194,70 @@ struct FilterPayload
 
     sst::filters::FilterUnitQFPtr func{nullptr};
     sst::filters::QuadFilterUnitState qfuState;
+
+    // The outgoing unit of a crossfaded model change, if one has been provided, runs until
+    // fadeRemaining samples have passed
+    CrossfadeState *crossfade{nullptr};
+    int fadeRemaining{0};
     std::array<sst::filters::FilterCoefficientMaker<>, 4>
         makers; // later option to externalize this
 
     using modelConfig_t = sst::filtersplusplus::ModelConfig;
     using legacyType_t = std::pair<sst::filters::FilterType, sst::filters::FilterSubType>;
-    using configMap_t = std::unordered_map<modelConfig_t, legacyType_t>;
+    using configEntry_t = std::pair<modelConfig_t, legacyType_t>;
+
+    /*
+     * Each model has a constexpr table of its configurations sorted by ModelConfig, so
+     * resolving a configuration is a binary search with no hashing or allocation, and can
+     * happen at compile time.
+     */
+    static constexpr std::span<const configEntry_t> configurationTable(FilterModel m);
+    static constexpr std::span<const ModelConfig> modelConfigurations(FilterModel m);
 
     legacyType_t resolveLegacyType();
-    static std::optional<legacyType_t> resolveLegacyTypeFor(const FilterModel &,
-                                                            const ModelConfig &);
+    static constexpr std::optional<legacyType_t> resolveLegacyTypeFor(const FilterModel &,
+                                                                      const ModelConfig &);
 
     modelConfig_t currentModelConfig{};
     legacyType_t currentLegacyType{};
 
+    // what the current unit uses of qfuState. This starts as the whole state so a reset
+    // before prepareInstance clears everything
+    sst::filters::FilterUnitTraits traits{};
+
     void provideDelayLine(int voice, float *m) { externalDelayLines[voice] = m; }
     std::array<float *, 4> externalDelayLines{};
 };
 
+template <size_t N>
+constexpr std::array<FilterPayload::configEntry_t, N>
+sortedConfigurations(std::array<FilterPayload::configEntry_t, N> t)
+{
+    std::sort(t.begin(), t.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    return t;
+}
+
+/*
+ * The lookups binary search a sorted table, so a repeated key would make one of its entries
+ * unreachable. Each model static_asserts this on its table.
+ */
+template <size_t N>
+constexpr bool hasUniqueConfigurations(const std::array<FilterPayload::configEntry_t, N> &t)
+{
+    for (size_t i = 1; i < N; ++i)
+        if (!(t[i - 1].first < t[i].first))
+            return false;
+    return true;
+}
+
+template <const auto &table>
+inline constexpr auto configurationKeys{[]() {
+    std::array<ModelConfig, std::tuple_size_v<std::remove_cvref_t<decltype(table)>>> res{};
+    for (size_t i = 0; i < res.size(); ++i)
+        res[i] = table[i].first;
+    return res;
+}()};
+
 }; // namespace sst::filtersplusplus::details
 
 #include "../models/VemberClassic.h"
@@ -203,24 +297,14 @@ inline FilterPayload::legacyType_t FilterPayload::resolveLegacyType()
     return currentLegacyType;
 }
 
-inline std::optional<FilterPayload::legacyType_t>
-FilterPayload::resolveLegacyTypeFor(const FilterModel &fm, const ModelConfig &mc)
+constexpr std::span<const FilterPayload::configEntry_t>
+FilterPayload::configurationTable(FilterModel m)
 {
-
 #define FILTER_MODEL_CASE(model, ns)                                                               \
     case model:                                                                                    \
-    {                                                                                              \
-        namespace ms = ns;                                                                         \
-        const auto &s = ms::getModelConfigurations();                                              \
-        auto pos = s.find(mc);                                                                     \
-        if (pos != s.end())                                                                        \
-        {                                                                                          \
-            return pos->second;                                                                    \
-        }                                                                                          \
-    }                                                                                              \
-    break;
-
-    switch (fm)
+        return ns::configurations;
+
+    switch (m)
     {
         FILTER_MODEL_CASE(FilterModel::VemberLadder, models::vemberladder);
         FILTER_MODEL_CASE(FilterModel::K35, models::k35);
@@ -237,30 +321,18 @@ FilterPayload::resolveLegacyTypeFor(const FilterModel &fm, const ModelConfig &mc
         FILTER_MODEL_CASE(FilterModel::TriPole, models::tripole);
         FILTER_MODEL_CASE(FilterModel::CytomicSVF, models::cytomicsvf);
     default:
-        // remove this
         break;
     }
 #undef FILTER_MODEL_CASE
 
-    return std::nullopt;
+    return {};
 }
 
-inline std::vector<ModelConfig> FilterPayload::availableModelConfigurations(FilterModel m,
-                                                                            bool sort)
+constexpr std::span<const ModelConfig> FilterPayload::modelConfigurations(FilterModel m)
 {
 #define FILTER_MODEL_CASE(model, ns)                                                               \
     case model:                                                                                    \
-    {                                                                                              \
-        namespace ms = ns;                                                                         \
-        const auto &s = ms::getModelConfigurations();                                              \
-        std::vector<ModelConfig> ret;                                                              \
-        for (const auto &[k, v] : s)                                                               \
-            ret.push_back(k);                                                                      \
-        if (sort)                                                                                  \
-            std::sort(ret.begin(), ret.end());                                                     \
-        return ret;                                                                                \
-    }                                                                                              \
-    break;
+        return configurationKeys<ns::configurations>;
 
     switch (m)
     {
@@ -279,15 +351,32 @@ inline std::vector<ModelConfig> FilterPayload::availableModelConfigurations(Filt
         FILTER_MODEL_CASE(FilterModel::TriPole, models::tripole);
         FILTER_MODEL_CASE(FilterModel::CytomicSVF, models::cytomicsvf);
     default:
-        // remove this
         break;
     }
-
 #undef FILTER_MODEL_CASE
 
     return {};
 }
 
+constexpr std::optional<FilterPayload::legacyType_t>
+FilterPayload::resolveLegacyTypeFor(const FilterModel &fm, const ModelConfig &mc)
+{
+    auto table = configurationTable(fm);
+    auto pos = std::lower_bound(table.begin(), table.end(), mc,
+                                [](const auto &e, const auto &k) { return e.first < k; });
+    if (pos != table.end() && pos->first == mc)
+        return pos->second;
+    return std::nullopt;
+}
+
+inline std::vector<ModelConfig> FilterPayload::availableModelConfigurations(FilterModel m,
+                                                                            bool sort)
+{
+    // The tables are sorted already, so sort is kept only for compatibility
+    auto s = modelConfigurations(m);
+    return {s.begin(), s.end()};
+}
+
 } // namespace sst::filtersplusplus::details
 
 #endif // FILTER_PAYLOAD_H
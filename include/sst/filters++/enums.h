@@ -165,6 +165,21 @@ enum struct FilterSubModel : uint32_t
 
 std::string toString(const FilterSubModel &s);
 
+/**
+ * How accurately the saturating models (warps, K35, vintage and tri-pole) evaluate their
+ * nonlinearities. This is a property of the Filter instance rather than of the model
+ * configuration. Standard is the historical behaviour and is right for live voices;
+ * Accurate is meant for offline renders and Cheap for very large voice counts.
+ */
+enum struct NonlinearityQuality : uint32_t
+{
+    Cheap = 0x10,
+    Standard = 0x20,
+    Accurate = 0x30
+};
+
+std::string toString(const NonlinearityQuality &q);
+
 template <typename T>
 concept is_modelconfig_enum = std::is_same_v<T, Passband> || std::is_same_v<T, Slope> ||
                               std::is_same_v<T, DriveMode> || std::is_same_v<T, FilterSubModel>;
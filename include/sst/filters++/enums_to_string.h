@@ -247,5 +247,19 @@ inline std::string toString(const FilterSubModel &s)
     return "SUBMODEL_ERROR";
 }
 
+inline std::string toString(const NonlinearityQuality &q)
+{
+    switch (q)
+    {
+    case NonlinearityQuality::Cheap:
+        return "Cheap";
+    case NonlinearityQuality::Standard:
+        return "Standard";
+    case NonlinearityQuality::Accurate:
+        return "Accurate";
+    }
+    return "QUALITY_ERROR";
+}
+
 } // namespace sst::filtersplusplus
 #endif // ENUMS_TO_STRING_H
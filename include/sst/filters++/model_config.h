@@ -24,17 +24,20 @@ namespace sst::filtersplusplus
 
 struct ModelConfig
 {
-    ModelConfig() {}
-    ModelConfig(Passband p, Slope s, DriveMode d, FilterSubModel m) : pt(p), st(s), dt(d), mt(m) {}
-    ModelConfig(Passband p) : pt(p) {}
-    ModelConfig(Slope s) : st(s) {}
-    ModelConfig(Passband p, Slope s, DriveMode d) : pt(p), st(s), dt(d) {}
-    ModelConfig(Passband p, DriveMode d) : pt(p), dt(d) {}
-    ModelConfig(Passband p, Slope s) : pt(p), st(s) {}
-    ModelConfig(Passband p, FilterSubModel m) : pt(p), mt(m) {}
-    ModelConfig(Passband p, DriveMode d, FilterSubModel m) : pt(p), dt(d), mt(m) {}
-    ModelConfig(Passband p, Slope s, FilterSubModel m) : pt(p), st(s), mt(m) {}
-    ModelConfig(Slope s, FilterSubModel m) : st(s), mt(m) {}
+    constexpr ModelConfig() {}
+    constexpr ModelConfig(Passband p, Slope s, DriveMode d, FilterSubModel m)
+        : pt(p), st(s), dt(d), mt(m)
+    {
+    }
+    constexpr ModelConfig(Passband p) : pt(p) {}
+    constexpr ModelConfig(Slope s) : st(s) {}
+    constexpr ModelConfig(Passband p, Slope s, DriveMode d) : pt(p), st(s), dt(d) {}
+    constexpr ModelConfig(Passband p, DriveMode d) : pt(p), dt(d) {}
+    constexpr ModelConfig(Passband p, Slope s) : pt(p), st(s) {}
+    constexpr ModelConfig(Passband p, FilterSubModel m) : pt(p), mt(m) {}
+    constexpr ModelConfig(Passband p, DriveMode d, FilterSubModel m) : pt(p), dt(d), mt(m) {}
+    constexpr ModelConfig(Passband p, Slope s, FilterSubModel m) : pt(p), st(s), mt(m) {}
+    constexpr ModelConfig(Slope s, FilterSubModel m) : st(s), mt(m) {}
 
     Passband pt{Passband::UNSUPPORTED};
     Slope st{Slope::UNSUPPORTED};
@@ -69,11 +72,11 @@ struct ModelConfig
     }
 };
 
-template <is_modelconfig_enum T> static T get(const ModelConfig &mc);
-template <> inline Passband get<Passband>(const ModelConfig &mc) { return mc.pt; }
-template <> inline Slope get<Slope>(const ModelConfig &mc) { return mc.st; }
-template <> inline DriveMode get<DriveMode>(const ModelConfig &mc) { return mc.dt; }
-template <> inline FilterSubModel get<FilterSubModel>(const ModelConfig &mc) { return mc.mt; }
+template <is_modelconfig_enum T> static constexpr T get(const ModelConfig &mc);
+template <> constexpr Passband get<Passband>(const ModelConfig &mc) { return mc.pt; }
+template <> constexpr Slope get<Slope>(const ModelConfig &mc) { return mc.st; }
+template <> constexpr DriveMode get<DriveMode>(const ModelConfig &mc) { return mc.dt; }
+template <> constexpr FilterSubModel get<FilterSubModel>(const ModelConfig &mc) { return mc.mt; }
 
 template <is_modelconfig_enum T> static void set(ModelConfig &mc, const T &t);
 template <> inline void set<Passband>(ModelConfig &mc, const Passband &t) { mc.pt = t; }
@@ -81,12 +84,12 @@ template <> inline void set<Slope>(ModelConfig &mc, const Slope &t) { mc.st = t;
 template <> inline void set<DriveMode>(ModelConfig &mc, const DriveMode &t) { mc.dt = t; }
 template <> inline void set<FilterSubModel>(ModelConfig &mc, const FilterSubModel &t) { mc.mt = t; }
 
-inline bool operator==(const ModelConfig &lhs, const ModelConfig &rhs) noexcept
+constexpr bool operator==(const ModelConfig &lhs, const ModelConfig &rhs) noexcept
 {
     return lhs.pt == rhs.pt && lhs.st == rhs.st && lhs.dt == rhs.dt && lhs.mt == rhs.mt;
 }
 
-inline bool operator<(const ModelConfig &lhs, const ModelConfig &rhs) noexcept
+constexpr bool operator<(const ModelConfig &lhs, const ModelConfig &rhs) noexcept
 {
 #define L(x)                                                                                       \
     if (lhs.x != rhs.x)                                                                            \
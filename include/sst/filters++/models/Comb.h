@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::comb
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Slope::Comb_Positive_50}, {sft::FilterType::fut_comb_pos, sft::FilterSubType(0)}},
         {{Slope::Comb_Positive_100}, {sft::FilterType::fut_comb_pos, sft::FilterSubType(1)}},
         {{Slope::Comb_Negative_50}, {sft::FilterType::fut_comb_neg, sft::FilterSubType(0)}},
@@ -36,10 +36,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_comb_pos, sft::st_comb_continuous_neg}},
         {{Slope::Comb_Bipolar_ContinuousMix},
          {sft::FilterType::fut_comb_pos, sft::st_comb_continuous_posneg}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::comb
 
 #endif // COMB_H
@@ -18,46 +18,47 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
+#include <utility>
 
 namespace sst::filtersplusplus::models::cutoffwarp
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{};
 
-    if (configs.empty())
+    // This one is too tedious to not fill programatically
+    constexpr std::pair<Passband, sft::FilterType> passbands[]{
+        {Passband::LP, sft::FilterType::fut_cutoffwarp_lp},
+        {Passband::HP, sft::FilterType::fut_cutoffwarp_hp},
+        {Passband::BP, sft::FilterType::fut_cutoffwarp_bp},
+        {Passband::Notch, sft::FilterType::fut_cutoffwarp_n},
+        {Passband::Allpass, sft::FilterType::fut_cutoffwarp_ap}};
+    constexpr std::pair<DriveMode, int> drives[]{
+        {DriveMode::Tanh, 0}, {DriveMode::SoftClip, 4}, {DriveMode::OJD, 8}};
+    constexpr FilterSubModel stages[]{FilterSubModel::Warp_1Stage, FilterSubModel::Warp_2Stage,
+                                      FilterSubModel::Warp_3Stage, FilterSubModel::Warp_4Stage};
+
+    std::array<details::FilterPayload::configEntry_t, 5 * 3 * 4> res{};
+    size_t i{0};
+    for (auto [pt, qft] : passbands)
     {
-        // This one is too tedious to not fill programatically
-        for (auto [pt, qft] : {std::make_pair(Passband::LP, sft::FilterType::fut_cutoffwarp_lp),
-                               {Passband::HP, sft::FilterType::fut_cutoffwarp_hp},
-                               {Passband::BP, sft::FilterType::fut_cutoffwarp_bp},
-                               {Passband::Notch, sft::FilterType::fut_cutoffwarp_n},
-                               {Passband::Allpass, sft::FilterType::fut_cutoffwarp_ap}})
+        for (auto [dt, off] : drives)
         {
-            for (auto [dt, off] : {std::make_pair(DriveMode::Tanh, 0),
-                                   {DriveMode::SoftClip, 4},
-                                   {DriveMode::OJD, 8}})
+            auto idx{0};
+            for (auto sm : stages)
             {
-                auto idx{0};
-                for (auto sm : {FilterSubModel::Warp_1Stage, FilterSubModel::Warp_2Stage,
-                                FilterSubModel::Warp_3Stage, FilterSubModel::Warp_4Stage})
-                {
-                    auto key = details::FilterPayload::modelConfig_t{pt, dt, sm};
-                    auto fv =
-                        (uint32_t)sst::filters::FilterSubType::st_cutoffwarp_tanh1 + off + idx;
-                    ;
-
-                    auto old = std::make_pair(qft, (sst::filters::FilterSubType)fv);
-                    configs[key] = old;
-                    idx++;
-                }
+                auto fv = (uint32_t)sft::FilterSubType::st_cutoffwarp_tanh1 + off + idx;
+                res[i++] = {{pt, dt, sm}, {qft, (sft::FilterSubType)fv}};
+                idx++;
             }
         }
     }
-    return configs;
+    return res;
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::cutoffwarp
 
 #endif // CUTOFFWARP_H
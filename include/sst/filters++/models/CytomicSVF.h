@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::cytomicsvf
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_lp}},
         {{Passband::HP}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_hp}},
         {{Passband::BP}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_bp}},
@@ -34,16 +34,16 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
         {{Passband::Peak}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_peak}},
         {{Passband::Allpass},
          {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_allpass}},
-        {{Passband::LP}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_lp}},
         {{Passband::LowShelf},
          {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_lowshelf}},
         {{Passband::HighShelf},
          {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_highshelf}},
         {{Passband::Bell}, {sft::FilterType::fut_cytomic_svf, sft::FilterSubType::st_cytomic_bell}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::cytomicsvf
 
 #endif // CYTOMICSVF_H
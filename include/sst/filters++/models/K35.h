@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::k35
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, DriveMode::K35_None},
          {sft::FilterType::fut_k35_lp, sft::FilterSubType::st_k35_none}},
         {{Passband::LP, DriveMode::K35_Mild},
@@ -51,9 +51,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_k35_hp, sft::FilterSubType::st_k35_extreme}},
         {{Passband::HP, DriveMode::K35_Continuous},
          {sft::FilterType::fut_k35_hp, sft::FilterSubType::st_k35_continuous}},
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::k35
 
 #endif // K35_H
@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::obxd_2pole
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, DriveMode::Standard},
          {sft::FilterType::fut_obxd_2pole_lp, sft::FilterSubType::st_obxd2pole_standard}},
         {{Passband::LP, DriveMode::Pushed},
@@ -45,10 +45,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_obxd_2pole_n, sft::FilterSubType::st_obxd2pole_standard}},
         {{Passband::Notch, DriveMode::Pushed},
          {sft::FilterType::fut_obxd_2pole_n, sft::FilterSubType::st_obxd2pole_pushed}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::obxd_2pole
 
 #endif // OBXF_2POLE_H
@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::obxd_4pole
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, Slope::Slope_6dB},
          {sft::FilterType::fut_obxd_4pole, sft::FilterSubType::st_obxd4pole_6dB}},
         {{Passband::LP, Slope::Slope_12dB},
@@ -39,9 +39,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
 
         {{Passband::LP, Slope::Slope_Morph},
          {sft::FilterType::fut_obxd_4pole, sft::FilterSubType::st_obxd4pole_morph}},
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::obxd_4pole
 
 #endif // OBXF_4POLE_H
@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::obxd_xpander
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, Slope::Slope_6dB},
          {sft::FilterType::fut_obxd_xpander, sft::FilterSubType::st_obxdxpander_lp1}},
         {{Passband::LP, Slope::Slope_12dB},
@@ -60,9 +60,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_obxd_xpander, sft::FilterSubType::st_obxdxpander_n2lp1}},
         {{Passband::PhaserAndLP, Slope::Slope_18dB6dB},
          {sft::FilterType::fut_obxd_xpander, sft::FilterSubType::st_obxdxpander_ph3lp1}},
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::obxd_xpander
 
 #endif // OBXF_4POLE_H
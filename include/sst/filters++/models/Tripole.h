@@ -19,14 +19,14 @@
 #include "sst/filters.h"
 #include "sst/filters++/enums.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::tripole
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LowLowLow, FilterSubModel::First_output},
          {sft::FilterType::fut_tripole, sft::FilterSubType::st_tripole_LLL1}},
         {{Passband::LowLowLow, FilterSubModel::Second_output},
@@ -54,10 +54,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_tripole, sft::FilterSubType::st_tripole_HHH2}},
         {{Passband::HighHighHigh, FilterSubModel::Third_output},
          {sft::FilterType::fut_tripole, sft::FilterSubType::st_tripole_HHH3}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::tripole
 
 #endif // TRIPOLE_H
@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::vemberclassic
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, Slope::Slope_12dB, DriveMode::Standard},
          {sft::FilterType::fut_lp12, sft::FilterSubType::st_Standard}},
         {{Passband::LP, Slope::Slope_24dB, DriveMode::Standard},
@@ -75,10 +75,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_notch24, sft::FilterSubType::st_NotchMild}},
 
         {{Passband::Allpass}, {sft::FilterType::fut_apf, sft::FilterSubType::st_Standard}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::vemberclassic
 
 #endif // VEMBERCLASSIC_H
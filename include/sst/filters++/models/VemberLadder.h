@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::vemberladder
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, Slope::Slope_6dB},
          {sft::FilterType::fut_lpmoog, sft::FilterSubType::st_lpmoog_6dB}},
         {{Passband::LP, Slope::Slope_12dB},
@@ -34,10 +34,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_lpmoog, sft::FilterSubType::st_lpmoog_18dB}},
         {{Passband::LP, Slope::Slope_24dB},
          {sft::FilterType::fut_lpmoog, sft::FilterSubType::st_lpmoog_24dB}},
-
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::vemberladder
 
 #endif // VEMBERLADDER_H
@@ -18,14 +18,14 @@
 
 #include "sst/filters.h"
 
-#include <unordered_set>
+#include <array>
 
 namespace sst::filtersplusplus::models::vintageladder
 {
-inline const details::FilterPayload::configMap_t &getModelConfigurations()
+constexpr auto makeConfigurations()
 {
     namespace sft = sst::filters;
-    static details::FilterPayload::configMap_t configs{
+    return std::to_array<details::FilterPayload::configEntry_t>({
         {{Passband::LP, FilterSubModel::RungeKutta},
          {sft::FilterType::fut_vintageladder, sft::FilterSubType::st_vintage_type1}},
         {{Passband::LP, FilterSubModel::RungeKuttaCompensated},
@@ -38,9 +38,11 @@ inline const details::FilterPayload::configMap_t &getModelConfigurations()
          {sft::FilterType::fut_vintageladder, sft::FilterSubType::st_vintage_type3}},
         {{Passband::LP, FilterSubModel::HuovCompensated2010},
          {sft::FilterType::fut_vintageladder, sft::FilterSubType::st_vintage_type3_compensated}},
-    };
-    return configs;
+    });
 }
+inline constexpr auto configurations{details::sortedConfigurations(makeConfigurations())};
+static_assert(details::hasUniqueConfigurations(configurations),
+              "Each ModelConfig may appear only once");
 } // namespace sst::filtersplusplus::models::vintageladder
 
 #endif // VINTAGELADDER_H
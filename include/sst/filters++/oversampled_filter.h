@@ -0,0 +1,288 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+
+#ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_OVERSAMPLED_FILTER_H
+#define INCLUDE_SST_FILTERS_PLUS_PLUS_OVERSAMPLED_FILTER_H
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "sst/filters/HalfRateFilter.h"
+#include "sst/filters/CascadedOversampler.h"
+
+#include "api.h"
+
+namespace sst::filtersplusplus
+{
+
+/**
+ * @brief A Filter which runs its model at 2, 4 or 8 times the host sample rate
+ *
+ * Models with strong nonlinearities (the OB-Xd, diode and warp families for instance) alias
+ * at the base rate. Rather than oversample an entire voice, an OversampledFilter upsamples
+ * only the filter input through a chain of half rate stages, runs the model at the higher rate
+ * and decimates back down, on all four voices at once.
+ *
+ * Configure it exactly like a Filter. The sample rate and block size you set are the host
+ * values; coefficients are made for the oversampled rate and are interpolated across the
+ * oversampled block, so the usual makeCoefficients / prepareBlock / processSample /
+ * concludeBlock cycle is unchanged and processSample is still called getBlockSize() times
+ * per block.
+ *
+ * The rate dependent methods here replace those on Filter rather than override them, so the
+ * Filter base is protected and an OversampledFilter cannot be passed where a Filter is
+ * expected; through one the model would run at the host rate with oversampled coefficients.
+ *
+ * ```cpp
+ *      auto filter = sfpp::OversampledFilter();
+ *      filter.setOversamplingFactor(4);
+ *      filter.setSampleRateAndBlockSize(48000, 16);
+ *      filter.setFilterModel(sfpp::FilterModel::DiodeLadder);
+ *      ...
+ *      auto delay = filter.getLatency(); // in host samples
+ * ```
+ */
+struct OversampledFilter : protected Filter
+{
+    static constexpr int maxOversamplingStages{3};
+    static constexpr int maxOversamplingFactor{1 << maxOversamplingStages};
+
+    using Filter::getFilterModel;
+    using Filter::getModelConfiguration;
+    using Filter::setDriveMode;
+    using Filter::setFilterModel;
+    using Filter::setModelConfiguration;
+    using Filter::setPassband;
+    using Filter::setSlope;
+    using Filter::setSubmodel;
+
+    using Filter::getNonlinearityQuality;
+    using Filter::setNonlinearityQuality;
+
+    using Filter::displayName;
+    using Filter::getFilterUnitTraits;
+
+    using Filter::availableModelConfigurations;
+    using Filter::availableModels;
+    using Filter::coefficientsExtraCount;
+    using Filter::coefficientsExtraIsBipolar;
+    using Filter::getFilterUnitTraitsFor;
+    using Filter::getLegacyTypeFor;
+    using Filter::legacyType_t;
+    using Filter::modelConfigurations;
+    using Filter::requiredDelayLinesSizes;
+
+    using Filter::provideAllDelayLines;
+    using Filter::provideDelayLine;
+
+    using Filter::CrossfadeState;
+    using Filter::isCrossfading;
+    using Filter::provideCrossfadeState;
+    using Filter::requiresPreparation;
+
+    using Filter::setActive;
+    using Filter::setMono;
+    using Filter::setQuad;
+    using Filter::setStereo;
+
+    using Filter::copyCoefficientsFromVoiceToVoice;
+    using Filter::freezeCoefficientsFor;
+    using Filter::makeCoefficients;
+    using Filter::makeConstantCoefficients;
+
+    using Filter::concludeBlock;
+    using Filter::prepareBlock;
+
+    using Filter::resetVoice;
+
+    /**
+     * Set the oversampling factor to 1, 2, 4 or 8. This re-applies the sample rate and block
+     * size, so call it before setSampleRateAndBlockSize or call that again afterwards, and
+     * then call prepareInstance.
+     */
+    void setOversamplingFactor(int factor)
+    {
+        assert(factor == 1 || factor == 2 || factor == 4 || factor == 8);
+        oversamplingStages = 0;
+        while ((1 << oversamplingStages) < factor && oversamplingStages < maxOversamplingStages)
+            oversamplingStages++;
+
+        if (baseSampleRate > 0)
+            setSampleRateAndBlockSize(baseSampleRate, baseBlockSize);
+        payload.valid = false;
+    }
+    int getOversamplingFactor() const { return 1 << oversamplingStages; }
+
+    void setSampleRateAndBlockSize(double sampleRate, size_t blockSize)
+    {
+        baseSampleRate = sampleRate;
+        baseBlockSize = blockSize;
+        Filter::setSampleRateAndBlockSize(sampleRate * getOversamplingFactor(),
+                                          blockSize * getOversamplingFactor());
+    }
+
+    /**
+     * The block size at the host rate, which is the number of processSample calls between
+     * prepareBlock and concludeBlock.
+     */
+    size_t getBlockSize() const { return baseBlockSize; }
+
+    /**
+     * The low frequency delay the resampling adds, in samples at the host rate. This does
+     * not include any delay in the filter model itself.
+     */
+    float getLatency() const
+    {
+        float res{0.f};
+        for (int s = 0; s < oversamplingStages; ++s)
+            res += stages[s].up.latency() / (1 << s);
+        return res;
+    }
+
+    [[nodiscard]] bool prepareInstance()
+    {
+        resetOversamplingStages();
+        return Filter::prepareInstance();
+    }
+
+    /**
+     * The fade is in host samples. The resampling stages carry on through a fade, since the
+     * new model takes over the same oversampled stream. A change which does not fade (no
+     * crossfade state, no model to fade from, or a zero length) is a hard switch and resets
+     * the stages just as prepareInstance does.
+     */
+    [[nodiscard]] bool prepareInstanceWithCrossfade(int fadeSamples)
+    {
+        auto res = Filter::prepareInstanceWithCrossfade(fadeSamples * getOversamplingFactor());
+        if (!isCrossfading())
+            resetOversamplingStages();
+        return res;
+    }
+
+    void init()
+    {
+        Filter::init();
+        resetOversamplingStages();
+    }
+
+    void reset()
+    {
+        Filter::reset();
+        resetOversamplingStages();
+    }
+
+    SIMD_M128 processSample(SIMD_M128 in)
+    {
+        if (oversamplingStages == 0)
+            return Filter::processSample(in);
+
+        SIMD_M128 bufA[maxOversamplingFactor], bufB[maxOversamplingFactor];
+        SIMD_M128 *src = bufA, *dst = bufB;
+        src[0] = in;
+
+        // Each up stage doubles the sample count
+        int n{1};
+        for (int s = 0; s < oversamplingStages; ++s)
+        {
+            for (int i = 0; i < n; ++i)
+                stages[s].up.process_sample_U2(src[i], &dst[2 * i]);
+            std::swap(src, dst);
+            n <<= 1;
+        }
+
+        for (int i = 0; i < n; ++i)
+            src[i] = Filter::processSample(src[i]);
+
+        // and each down stage halves it again. Output i only reads 2i and 2i + 1 so this
+        // can run in place
+        for (int s = oversamplingStages - 1; s >= 0; --s)
+        {
+            n >>= 1;
+            for (int i = 0; i < n; ++i)
+                src[i] = stages[s].down.process_sample_D2(&src[2 * i]);
+        }
+
+        return src[0];
+    }
+
+    void processBlock(const float *const *in, float **out, int nChannels, int nSamples,
+                      std::span<const FilterEvent> events = {})
+    {
+        processPlanarBlockWith(
+            baseBlockSize, [this](SIMD_M128 x) { return processSample(x); }, in, out, nChannels,
+            nSamples, events);
+    }
+
+    void processInterleavedBlock(const float *in, float *out, int nChannels, int nSamples,
+                                 std::span<const FilterEvent> events = {})
+    {
+        processInterleavedBlockWith(
+            baseBlockSize, [this](SIMD_M128 x) { return processSample(x); }, in, out, nChannels,
+            nSamples, events);
+    }
+
+    float processMonoSample(float in)
+    {
+        auto res = processSample(SIMD_MM(set1_ps)(in));
+        return SIMD_MM(cvtss_f32)(res);
+    }
+
+    void processStereoSample(float inL, float inR, float &outL, float &outR)
+    {
+        auto res = processSample(SIMD_MM(set_ps)(0., 0., inR, inL));
+        float rf alignas(16)[4];
+        SIMD_MM(store_ps)(rf, res);
+        outL = rf[0];
+        outR = rf[1];
+    }
+
+    void processQuadSample(float in[4], float out[4])
+    {
+        auto res = processSample(SIMD_MM(loadu_ps)(in));
+        SIMD_MM(storeu_ps)(out, res);
+    }
+
+  protected:
+    struct Stage
+    {
+        explicit Stage(sst::filters::HalfRate::StageSettings st)
+            : up(st.M, st.steep), down(st.M, st.steep)
+        {
+        }
+
+        sst::filters::HalfRate::QuadHalfRateFilter up, down;
+    };
+    std::array<Stage, maxOversamplingStages> stages{
+        Stage(sst::filters::HalfRate::cascadeStageSettings(0)),
+        Stage(sst::filters::HalfRate::cascadeStageSettings(1)),
+        Stage(sst::filters::HalfRate::cascadeStageSettings(2))};
+
+    void resetOversamplingStages()
+    {
+        for (auto &s : stages)
+        {
+            s.up.reset();
+            s.down.reset();
+        }
+    }
+
+    int oversamplingStages{0};
+    double baseSampleRate{0};
+    size_t baseBlockSize{0};
+};
+} // namespace sst::filtersplusplus
+
+#endif // OVERSAMPLED_FILTER_H
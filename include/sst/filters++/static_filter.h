@@ -0,0 +1,150 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+
+#ifndef INCLUDE_SST_FILTERS_PLUS_PLUS_STATIC_FILTER_H
+#define INCLUDE_SST_FILTERS_PLUS_PLUS_STATIC_FILTER_H
+
+#include "api.h"
+
+namespace sst::filtersplusplus
+{
+
+/**
+ * @brief A Filter whose model and configuration are fixed at compile time
+ *
+ * Fixed EQs, crossovers, DC blockers and the like know their filter when they are written.
+ * A StaticFilter resolves the model and configuration to a filter unit while compiling and
+ * calls it directly rather than through a function pointer, so the compiler can inline the
+ * filter into the surrounding DSP. An unsupported configuration is a compile error, and
+ * there is no prepareInstance; the object is ready once the sample rate is set.
+ *
+ * Otherwise it behaves exactly like a Filter with the same configuration: make
+ * coefficients, prepareBlock, processSample blockSize times, concludeBlock, or use
+ * processBlock.
+ *
+ * It holds one unit state and the voices' coefficient makers, and never crossfades, so it
+ * carries no second state. Every unit indexes the full QuadFilterUnitState layout, so the
+ * state itself cannot shrink to the model's registers, but resets only clear those and the
+ * rest of the state stays cold.
+ *
+ * ```cpp
+ *      auto dcBlock = sfpp::StaticFilter<sfpp::FilterModel::CytomicSVF, sfpp::Passband::HP>();
+ *      dcBlock.setSampleRateAndBlockSize(48000, 16);
+ *      dcBlock.setStereo();
+ *      dcBlock.makeConstantCoefficients(0, -60, 0);
+ *      dcBlock.copyCoefficientsFromVoiceToVoice(0, 1);
+ * ```
+ */
+template <FilterModel model, Passband passband = Passband::UNSUPPORTED,
+          Slope slope = Slope::UNSUPPORTED, DriveMode drive = DriveMode::UNSUPPORTED,
+          FilterSubModel subModel = FilterSubModel::UNSUPPORTED>
+struct StaticFilter : protected Filter
+{
+    static constexpr ModelConfig modelConfig{passband, slope, drive, subModel};
+    static constexpr auto legacyType{Filter::getLegacyTypeFor(model, modelConfig)};
+    static_assert(legacyType.has_value(),
+                  "StaticFilter model and configuration are not a supported combination");
+
+    static constexpr sst::filters::FilterUnitQFPtr filterUnit{
+        sst::filters::GetCompensatedQFPtrFilterUnit<false>(legacyType->first,
+                                                           legacyType->second)};
+    static_assert(filterUnit != nullptr, "StaticFilter configuration has no filter unit");
+
+    static constexpr sst::filters::FilterUnitTraits traits{
+        sst::filters::GetFilterUnitTraits(legacyType->first, legacyType->second)};
+
+    StaticFilter()
+    {
+        payload.setFilterModel(model);
+        payload.setModelConfiguration(modelConfig);
+        payload.currentModelConfig = modelConfig;
+        payload.currentLegacyType = *legacyType;
+        payload.func = filterUnit;
+        payload.valid = true;
+        reset();
+        payload.traits = traits;
+    }
+
+    using Filter::displayName;
+    using Filter::getFilterModel;
+    using Filter::getFilterUnitTraits;
+    using Filter::getModelConfiguration;
+
+    using Filter::getBlockSize;
+    using Filter::setSampleRateAndBlockSize;
+
+    using Filter::provideAllDelayLines;
+    using Filter::provideDelayLine;
+
+    using Filter::setActive;
+    using Filter::setMono;
+    using Filter::setQuad;
+    using Filter::setStereo;
+
+    using Filter::copyCoefficientsFromVoiceToVoice;
+    using Filter::freezeCoefficientsFor;
+    using Filter::makeCoefficients;
+    using Filter::makeConstantCoefficients;
+
+    using Filter::concludeBlock;
+    using Filter::prepareBlock;
+
+    using Filter::reset;
+    using Filter::resetVoice;
+
+    SIMD_M128 processSample(SIMD_M128 in) { return filterUnit(&payload.qfuState, in); }
+
+    float processMonoSample(float in)
+    {
+        auto res = processSample(SIMD_MM(set1_ps)(in));
+        return SIMD_MM(cvtss_f32)(res);
+    }
+
+    void processStereoSample(float inL, float inR, float &outL, float &outR)
+    {
+        auto res = processSample(SIMD_MM(set_ps)(0., 0., inR, inL));
+        float rf alignas(16)[4];
+        SIMD_MM(store_ps)(rf, res);
+        outL = rf[0];
+        outR = rf[1];
+    }
+
+    void processQuadSample(float in[4], float out[4])
+    {
+        auto res = processSample(SIMD_MM(loadu_ps)(in));
+        SIMD_MM(storeu_ps)(out, res);
+    }
+
+    void processBlock(const float *const *in, float **out, int nChannels, int nSamples,
+                      std::span<const FilterEvent> events = {})
+    {
+        auto *state = &payload.qfuState;
+        processPlanarBlockWith(
+            payload.blockSize, [state](SIMD_M128 x) { return filterUnit(state, x); }, in, out,
+            nChannels, nSamples, events);
+    }
+
+    void processInterleavedBlock(const float *in, float *out, int nChannels, int nSamples,
+                                 std::span<const FilterEvent> events = {})
+    {
+        auto *state = &payload.qfuState;
+        processInterleavedBlockWith(
+            payload.blockSize, [state](SIMD_M128 x) { return filterUnit(state, x); }, in, out,
+            nChannels, nSamples, events);
+    }
+};
+} // namespace sst::filtersplusplus
+
+#endif // STATIC_FILTER_H
@@ -47,6 +47,8 @@ namespace utilities
 #include "sst/filters/TriPoleFilter.h"
 
 #include "sst/filters/QuadFilterUnit_Impl.h"
+#include "sst/filters/FilterUnitTraits.h"
+#include "sst/filters/QuadFilterStateArena.h"
 #include "sst/filters/FilterCoefficientMaker_Impl.h"
 
 #endif
\ No newline at end of file
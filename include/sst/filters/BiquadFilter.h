@@ -17,7 +17,11 @@
 
 #include <utility>
 #include <algorithm>
+#include <cmath>
 #include <complex>
+#include <type_traits>
+
+#include "sst/basic-blocks/simd/setup.h"
 
 namespace sst::filters::Biquad
 {
@@ -34,23 +38,215 @@ template <typename TuningAndDBProvider> struct DefaultTuningAndDBAdapter
     static inline double sampleRateInv(ST *s) { return s->dsamplerate_inv; }
 };
 
+namespace details
+{
+/*
+ * The packed form of the coefficient lags and of one left / right sample of the recurrence,
+ * for each precision. The coefficients are held as (a1, a2), (b0, b1), (b2) pairs of doubles or
+ * as (a1, a2, b0, b1), (b2) floats, and the two channels sit in the low lanes of a register.
+ */
+template <typename P> struct BiquadEngine;
+
+template <> struct BiquadEngine<double>
+{
+    using reg_t = SIMD_M128D;
+
+    struct Lags
+    {
+        reg_t a12, b01, b2x, ta12, tb01, tb2x;
+
+        Lags(const double (&v)[5], const double (&t)[5])
+            : a12(SIMD_MM(set_pd)(v[1], v[0])), b01(SIMD_MM(set_pd)(v[3], v[2])),
+              b2x(SIMD_MM(set_sd)(v[4])), ta12(SIMD_MM(set_pd)(t[1], t[0])),
+              tb01(SIMD_MM(set_pd)(t[3], t[2])), tb2x(SIMD_MM(set_sd)(t[4]))
+        {
+        }
+
+        void store(double (&v)[5]) const
+        {
+            v[0] = SIMD_MM(cvtsd_f64)(a12);
+            v[1] = SIMD_MM(cvtsd_f64)(SIMD_MM(unpackhi_pd)(a12, a12));
+            v[2] = SIMD_MM(cvtsd_f64)(b01);
+            v[3] = SIMD_MM(cvtsd_f64)(SIMD_MM(unpackhi_pd)(b01, b01));
+            v[4] = SIMD_MM(cvtsd_f64)(b2x);
+        }
+
+        inline void process(double lp, double lpinv)
+        {
+            const auto vlp = SIMD_MM(set1_pd)(lp), vlpinv = SIMD_MM(set1_pd)(lpinv);
+            a12 = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(a12, vlpinv), SIMD_MM(mul_pd)(ta12, vlp));
+            b01 = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(b01, vlpinv), SIMD_MM(mul_pd)(tb01, vlp));
+            b2x = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(b2x, vlpinv), SIMD_MM(mul_pd)(tb2x, vlp));
+        }
+
+        inline reg_t a1() const { return SIMD_MM(unpacklo_pd)(a12, a12); }
+        inline reg_t a2() const { return SIMD_MM(unpackhi_pd)(a12, a12); }
+        inline reg_t b0() const { return SIMD_MM(unpacklo_pd)(b01, b01); }
+        inline reg_t b1() const { return SIMD_MM(unpackhi_pd)(b01, b01); }
+        inline reg_t b2() const { return SIMD_MM(unpacklo_pd)(b2x, b2x); }
+    };
+
+    static inline reg_t add(reg_t a, reg_t b) { return SIMD_MM(add_pd)(a, b); }
+    static inline reg_t sub(reg_t a, reg_t b) { return SIMD_MM(sub_pd)(a, b); }
+    static inline reg_t mul(reg_t a, reg_t b) { return SIMD_MM(mul_pd)(a, b); }
+    static inline double first(reg_t a) { return SIMD_MM(cvtsd_f64)(a); }
+
+    static inline reg_t pair(double L, double R) { return SIMD_MM(set_pd)(R, L); }
+    static inline reg_t loadPair(const double *d) { return SIMD_MM(load_pd)(d); }
+    static inline void storePair(double *d, reg_t a) { SIMD_MM(store_pd)(d, a); }
+};
+
+template <> struct BiquadEngine<float>
+{
+    using reg_t = SIMD_M128;
+
+    struct Lags
+    {
+        reg_t ab, b2x, tab, tb2x;
+
+        Lags(const float (&v)[5], const float (&t)[5])
+            : ab(SIMD_MM(set_ps)(v[3], v[2], v[1], v[0])), b2x(SIMD_MM(set_ss)(v[4])),
+              tab(SIMD_MM(set_ps)(t[3], t[2], t[1], t[0])), tb2x(SIMD_MM(set_ss)(t[4]))
+        {
+        }
+
+        void store(float (&v)[5]) const
+        {
+            float r alignas(16)[4];
+            SIMD_MM(store_ps)(r, ab);
+            v[0] = r[0];
+            v[1] = r[1];
+            v[2] = r[2];
+            v[3] = r[3];
+            v[4] = SIMD_MM(cvtss_f32)(b2x);
+        }
+
+        inline void process(float lp, float lpinv)
+        {
+            const auto vlp = SIMD_MM(set1_ps)(lp), vlpinv = SIMD_MM(set1_ps)(lpinv);
+            ab = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(ab, vlpinv), SIMD_MM(mul_ps)(tab, vlp));
+            b2x = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(b2x, vlpinv), SIMD_MM(mul_ps)(tb2x, vlp));
+        }
+
+        inline reg_t a1() const { return SIMD_MM(shuffle_ps)(ab, ab, SIMD_MM_SHUFFLE(0, 0, 0, 0)); }
+        inline reg_t a2() const { return SIMD_MM(shuffle_ps)(ab, ab, SIMD_MM_SHUFFLE(1, 1, 1, 1)); }
+        inline reg_t b0() const { return SIMD_MM(shuffle_ps)(ab, ab, SIMD_MM_SHUFFLE(2, 2, 2, 2)); }
+        inline reg_t b1() const { return SIMD_MM(shuffle_ps)(ab, ab, SIMD_MM_SHUFFLE(3, 3, 3, 3)); }
+        inline reg_t b2() const { return SIMD_MM(shuffle_ps)(b2x, b2x, 0); }
+    };
+
+    static inline reg_t add(reg_t a, reg_t b) { return SIMD_MM(add_ps)(a, b); }
+    static inline reg_t sub(reg_t a, reg_t b) { return SIMD_MM(sub_ps)(a, b); }
+    static inline reg_t mul(reg_t a, reg_t b) { return SIMD_MM(mul_ps)(a, b); }
+    static inline float first(reg_t a) { return SIMD_MM(cvtss_f32)(a); }
+
+    static inline reg_t pair(float L, float R) { return SIMD_MM(set_ps)(0.f, 0.f, R, L); }
+    static inline reg_t loadPair(const float *d) { return SIMD_MM(set_ps)(0.f, 0.f, d[1], d[0]); }
+    static inline void storePair(float *d, reg_t a)
+    {
+        float r alignas(16)[4];
+        SIMD_MM(store_ps)(r, a);
+        d[0] = r[0];
+        d[1] = r[1];
+    }
+};
+
+/** Normalised biquad coefficients, with a0 = 1 */
+struct BiquadCoefficients
+{
+    double a1, a2, b0, b1, b2;
+};
+
+/*
+ * The magnitude in dB of a cascade of biquads at many frequencies, for response plots. With
+ * phi = sin^2(w / 2) the squared magnitude of each section is a ratio of quadratics in phi
+ *
+ *   |H|^2 = ((b0 + b1 + b2)^2 - 4 (b0 b1 + 4 b0 b2 + b1 b2) phi + 16 b0 b2 phi^2) /
+ *           ((1 + a1 + a2)^2 - 4 (a1 + 4 a2 + a1 a2) phi + 16 a2 phi^2)
+ *
+ * which stays accurate for poles near z = 1, where expanding in cos(w) cancels badly. So each
+ * frequency needs one sine, shared by every section, and each section is a couple of packed
+ * polynomials per pair of frequencies. Frequencies are normalised to the sample rate.
+ */
+inline void plotMagnitudeBatch(const BiquadCoefficients *sections, size_t nSections,
+                               const float *freqs, float *dbOut, int n)
+{
+    static constexpr int chunk{64};
+    double phi alignas(16)[chunk], mag2 alignas(16)[chunk];
+
+    for (int start = 0; start < n; start += chunk)
+    {
+        const int m = std::min(chunk, n - start);
+        const int mp = (m + 1) & ~1;
+        for (int i = 0; i < mp; ++i)
+        {
+            // the same omega as plot_magnitude
+            const auto sh = i < m ? std::sin(3.1415 * freqs[start + i]) : 0.0;
+            phi[i] = sh * sh;
+            mag2[i] = 1.0;
+        }
+
+        for (size_t s = 0; s < nSections; ++s)
+        {
+            const auto &c = sections[s];
+            const auto n0 = SIMD_MM(set1_pd)((c.b0 + c.b1 + c.b2) * (c.b0 + c.b1 + c.b2));
+            const auto n1 = SIMD_MM(set1_pd)(4 * (c.b0 * c.b1 + 4 * c.b0 * c.b2 + c.b1 * c.b2));
+            const auto n2 = SIMD_MM(set1_pd)(16 * c.b0 * c.b2);
+            const auto d0 = SIMD_MM(set1_pd)((1 + c.a1 + c.a2) * (1 + c.a1 + c.a2));
+            const auto d1 = SIMD_MM(set1_pd)(4 * (c.a1 + 4 * c.a2 + c.a1 * c.a2));
+            const auto d2 = SIMD_MM(set1_pd)(16 * c.a2);
+
+            for (int i = 0; i < mp; i += 2)
+            {
+                const auto p = SIMD_MM(load_pd)(&phi[i]);
+                auto num = SIMD_MM(add_pd)(SIMD_MM(sub_pd)(n0, SIMD_MM(mul_pd)(n1, p)),
+                                           SIMD_MM(mul_pd)(SIMD_MM(mul_pd)(n2, p), p));
+                auto den = SIMD_MM(add_pd)(SIMD_MM(sub_pd)(d0, SIMD_MM(mul_pd)(d1, p)),
+                                           SIMD_MM(mul_pd)(SIMD_MM(mul_pd)(d2, p), p));
+                auto r = SIMD_MM(mul_pd)(SIMD_MM(load_pd)(&mag2[i]), SIMD_MM(div_pd)(num, den));
+                SIMD_MM(store_pd)(&mag2[i], r);
+            }
+        }
+
+        for (int i = 0; i < m; ++i)
+            dbOut[start + i] = (float)(10.0 * std::log10(std::max(mag2[i], 1e-30)));
+    }
+}
+} // namespace details
+
+/**
+ * A stereo biquad with smoothed coefficients.
+ *
+ * Precision is the type of the coefficients and registers. double is the safe choice for low
+ * cutoffs, where the poles sit close to z = 1; float halves the state, packs all four of
+ * a1, a2, b0 and b1 into one register and skips the conversions in and out of the float
+ * audio, which suits tone and EQ stages well away from DC.
+ */
 template <typename TuningAndDBProvider, size_t BLOCK_SIZE,
-          typename Adapter = DefaultTuningAndDBAdapter<TuningAndDBProvider>>
+          typename Adapter = DefaultTuningAndDBAdapter<TuningAndDBProvider>,
+          typename Precision = double>
 struct alignas(16) BiquadFilter
 {
+    static_assert(std::is_same_v<Precision, double> || std::is_same_v<Precision, float>,
+                  "BiquadFilter runs in float or double precision");
+
   private:
+    using P = Precision;
+    using engine_t = details::BiquadEngine<P>;
+    using reg_t = typename engine_t::reg_t;
+
     static constexpr double minBW = 0.0001;
-    static constexpr double d_lp = 0.004;
-    static constexpr double d_lpinv = 1.0 - 0.004;
+    static constexpr P d_lp = (P)0.004;
+    static constexpr P d_lpinv = (P)(1.0 - 0.004);
 
-    union vdouble
+    union vsample
     {
-        double d[2];
+        P d[2];
     };
     class vlag
     {
       public:
-        vdouble v alignas(16), target_v alignas(16);
+        vsample v alignas(16), target_v alignas(16);
         vlag() {}
         void init_x87()
         {
@@ -61,9 +257,9 @@ struct alignas(16) BiquadFilter
         }
 
         inline void process() { v.d[0] = v.d[0] * d_lpinv + target_v.d[0] * d_lp; }
-        inline void newValue(double f) { target_v.d[0] = f; }
+        inline void newValue(P f) { target_v.d[0] = f; }
         inline void instantize() { v = target_v; }
-        inline void startValue(double f)
+        inline void startValue(P f)
         {
             target_v.d[0] = f;
             v.d[0] = f;
@@ -71,9 +267,9 @@ struct alignas(16) BiquadFilter
     };
 
     vlag a1 alignas(16), a2 alignas(16), b0 alignas(16), b1 alignas(16), b2 alignas(16);
-    vdouble reg0 alignas(16), reg1 alignas(16);
+    vsample reg0 alignas(16), reg1 alignas(16);
 
-    inline void flush_denormal(double &d)
+    inline void flush_denormal(P &d)
     {
         if (fabs(d) < 1E-30)
         {
@@ -81,6 +277,96 @@ struct alignas(16) BiquadFilter
         }
     }
 
+    /*
+     * The block loops hold the five lagged coefficients packed for the block, so a lag step is
+     * a couple of packed multiply adds rather than five scalar ones, and run the left and
+     * right recurrences as one packed recurrence. The operations are those of process_sample,
+     * but a compiler may contract the scalar ones there to fused multiply adds, so the two
+     * agree to rounding rather than bit for bit.
+     */
+    using PackedLags = typename engine_t::Lags;
+
+    inline PackedLags loadLags() const
+    {
+        const P v[5] = {a1.v.d[0], a2.v.d[0], b0.v.d[0], b1.v.d[0], b2.v.d[0]};
+        const P t[5] = {a1.target_v.d[0], a2.target_v.d[0], b0.target_v.d[0],
+                        b1.target_v.d[0], b2.target_v.d[0]};
+        return PackedLags(v, t);
+    }
+
+    inline void storeLags(const PackedLags &p)
+    {
+        P v[5];
+        p.store(v);
+        a1.v.d[0] = v[0];
+        a2.v.d[0] = v[1];
+        b0.v.d[0] = v[2];
+        b1.v.d[0] = v[3];
+        b2.v.d[0] = v[4];
+    }
+
+    // One left / right sample of the recurrence, on packed registers
+    static inline reg_t stereoStep(reg_t in, const PackedLags &p, reg_t &r0, reg_t &r1)
+    {
+        using e = engine_t;
+        auto op = e::add(e::mul(in, p.b0()), r0);
+        r0 = e::add(e::sub(e::mul(in, p.b1()), e::mul(p.a1(), op)), r1);
+        r1 = e::sub(e::mul(in, p.b2()), e::mul(p.a2(), op));
+        return op;
+    }
+
+    // and a mono one on the left registers only, leaving the right ones alone
+    inline P monoStep(P input, const PackedLags &p)
+    {
+        using e = engine_t;
+        P op = input * e::first(p.b0()) + reg0.d[0];
+        reg0.d[0] = input * e::first(p.b1()) - e::first(p.a1()) * op + reg1.d[0];
+        reg1.d[0] = input * e::first(p.b2()) - e::first(p.a2()) * op;
+        return op;
+    }
+
+    template <bool lagPerSample, typename Source, typename Sink>
+    inline void processStereoBlock(Source &&source, Sink &&sink)
+    {
+        auto p = loadLags();
+        auto r0 = engine_t::loadPair(reg0.d);
+        auto r1 = engine_t::loadPair(reg1.d);
+
+        if constexpr (!lagPerSample)
+            p.process(d_lp, d_lpinv);
+
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+        {
+            if constexpr (lagPerSample)
+                p.process(d_lp, d_lpinv);
+
+            P op alignas(16)[2];
+            engine_t::storePair(op, stereoStep(source(k), p, r0, r1));
+            sink(k, op);
+        }
+
+        storeLags(p);
+        engine_t::storePair(reg0.d, r0);
+        engine_t::storePair(reg1.d, r1);
+        flush_denormal(reg0.d[0]);
+        flush_denormal(reg1.d[0]);
+        flush_denormal(reg0.d[1]);
+        flush_denormal(reg1.d[1]);
+    }
+
+    template <typename T, typename U> inline void processMonoBlock(const T *data, U *dataout)
+    {
+        auto p = loadLags();
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+        {
+            p.process(d_lp, d_lpinv);
+            dataout[k] = monoStep((P)data[k], p);
+        }
+        storeLags(p);
+        flush_denormal(reg0.d[0]);
+        flush_denormal(reg1.d[0]);
+    }
+
   public:
     BiquadFilter(TuningAndDBProvider *d = nullptr);
     void coeff_LP(double omega, double Q);
@@ -97,21 +383,19 @@ struct alignas(16) BiquadFilter
     void coeff_LPHPmorph(double omega, double Q, double morph);
     void coeff_APF(double omega, double Q);
     void coeff_orfanidisEQ(double omega, double BW, double pgaindb, double bgaindb, double zgain);
+    /** RBJ shelves, with the gain in dB at the shelf */
+    void coeff_lowShelf(double omega, double Q, double gain);
+    void coeff_highShelf(double omega, double Q, double gain);
     void coeff_same_as_last_time();
     void coeff_instantize();
 
     void process_block(float *data);
-    // void process_block_SSE2(float *data);
     void process_block(float *dataL, float *dataR);
-    // void process_block_SSE2(float *dataL,float *dataR);
     void process_block_to(const float *const, float *);
     void process_block_to(const float *const dataL, const float *const dataR, float *dstL,
                           float *dstR);
-    // void process_block_to_SSE2(float *dataL,float *dataR, float *dstL,float *dstR);
     void process_block_slowlag(float *dataL, float *dataR);
-    // void process_block_slowlag_SSE2(float *dataL,float *dataR);
     void process_block(double *data);
-    // void process_block_SSE2(double *data);
 
     inline float process_sample(float input)
     {
@@ -121,7 +405,7 @@ struct alignas(16) BiquadFilter
         b1.process();
         b2.process();
 
-        double op;
+        P op;
 
         op = input * b0.v.d[0] + reg0.d[0];
         reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
@@ -138,8 +422,8 @@ struct alignas(16) BiquadFilter
         b1.process();
         b2.process();
 
-        double op;
-        double input = L;
+        P op;
+        P input = L;
         op = input * b0.v.d[0] + reg0.d[0];
         reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
         reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
@@ -156,7 +440,7 @@ struct alignas(16) BiquadFilter
 
     inline void process_sample_nolag(float &L, float &R)
     {
-        double op;
+        P op;
 
         op = L * b0.v.d[0] + reg0.d[0];
         reg0.d[0] = L * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
@@ -171,7 +455,7 @@ struct alignas(16) BiquadFilter
 
     inline void process_sample_nolag(float &L, float &R, float &Lout, float &Rout)
     {
-        double op;
+        P op;
 
         op = L * b0.v.d[0] + reg0.d[0];
         reg0.d[0] = L * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
@@ -186,7 +470,7 @@ struct alignas(16) BiquadFilter
 
     inline void process_sample_nolag_noinput(float &Lout, float &Rout)
     {
-        double op;
+        P op;
 
         op = reg0.d[0];
         reg0.d[0] = -a1.v.d[0] * op + reg1.d[0];
@@ -231,8 +515,30 @@ struct alignas(16) BiquadFilter
     }
 
     float plot_magnitude(float f);
+    /**
+     * The magnitude in dB at n frequencies, normalised to the sample rate as in plot_magnitude.
+     * Much cheaper than n calls to plot_magnitude, for drawing response curves.
+     */
+    void plot_magnitude_batch(const float *freqs, float *dbOut, int n)
+    {
+        auto c = currentCoefficients();
+        details::plotMagnitudeBatch(&c, 1, freqs, dbOut, n);
+    }
     TuningAndDBProvider *storage{nullptr};
 
+    using Coefficients = details::BiquadCoefficients;
+    /** The normalised coefficients the lags are heading to, as set by the last coeff_ call */
+    Coefficients targetCoefficients() const
+    {
+        return {a1.target_v.d[0], a2.target_v.d[0], b0.target_v.d[0], b1.target_v.d[0],
+                b2.target_v.d[0]};
+    }
+    /** and the smoothed ones the filter is running now */
+    Coefficients currentCoefficients() const
+    {
+        return {a1.v.d[0], a2.v.d[0], b0.v.d[0], b1.v.d[0], b2.v.d[0]};
+    }
+
   protected:
     void set_coef(double a0, double a1, double a2, double b0, double b1, double b2);
     bool first_run;
@@ -240,8 +546,8 @@ struct alignas(16) BiquadFilter
 
 inline double square(double x) { return x * x; }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline BiquadFilter<D, BLOCK_SIZE, Adapter>::BiquadFilter(D *d) : storage(d)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline BiquadFilter<D, BLOCK_SIZE, Adapter, P>::BiquadFilter(D *d) : storage(d)
 {
     reg0.d[0] = 0;
     reg1.d[0] = 0;
@@ -258,8 +564,8 @@ inline BiquadFilter<D, BLOCK_SIZE, Adapter>::BiquadFilter(D *d) : storage(d)
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LP(double omega, double Q)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_LP(double omega, double Q)
 {
     if (omega > M_PI)
         set_coef(1, 0, 0, 1, 0, 0);
@@ -272,8 +578,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LP(double omega, double
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LP2B(double omega, double Q)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_LP2B(double omega, double Q)
 {
     if (omega > M_PI)
         set_coef(1, 0, 0, 1, 0, 0);
@@ -295,8 +601,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LP2B(double omega, doubl
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_HP(double omega, double Q)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_HP(double omega, double Q)
 {
     if (omega > M_PI)
         set_coef(1, 0, 0, 0, 0, 0);
@@ -310,8 +616,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_HP(double omega, double
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_BP(double omega, double Q)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_BP(double omega, double Q)
 {
     double cosi = cos(omega), sinu = sin(omega), alpha = sinu / (2.0 * Q), b0 = alpha, b2 = -alpha,
            a0 = 1 + alpha, a1 = -2 * cosi, a2 = 1 - alpha;
@@ -319,8 +625,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_BP(double omega, double
     set_coef(a0, a1, a2, b0, 0, b2);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_BP2A(double omega, double BW)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_BP2A(double omega, double BW)
 {
     double cosi = cos(omega), sinu = sin(omega), q = 1 / (0.02 + 30 * BW * BW),
            alpha = sinu / (2 * q), b0 = alpha, b2 = -alpha, a0 = 1 + alpha, a1 = -2 * cosi,
@@ -329,8 +635,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_BP2A(double omega, doubl
     set_coef(a0, a1, a2, b0, 0, b2);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_PKA(double omega, double QQ)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_PKA(double omega, double QQ)
 {
     double cosi = cos(omega), sinu = sin(omega), reso = std::clamp(QQ, 0.0, 1.0),
            q = 0.1 + 10 * reso * reso, alpha = sinu / (2 * q), b0 = q * alpha, b2 = -q * alpha,
@@ -339,8 +645,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_PKA(double omega, double
     set_coef(a0, a1, a2, b0, 0, b2);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_NOTCH(double omega, double QQ)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_NOTCH(double omega, double QQ)
 {
     if (omega > M_PI)
         set_coef(1, 0, 0, 1, 0, 0);
@@ -354,21 +660,21 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_NOTCH(double omega, doub
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LP_with_BW(double omega, double BW)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_LP_with_BW(double omega, double BW)
 {
     coeff_LP(omega, 1 / BW);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_HP_with_BW(double omega, double BW)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_HP_with_BW(double omega, double BW)
 {
     coeff_HP(omega, 1 / BW);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LPHPmorph(double omega, double Q,
-                                                                  double morph)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_LPHPmorph(double omega, double Q,
+                                                                     double morph)
 {
     double HP = std::clamp(morph, 0.0, 1.0), LP = 1 - HP; // , BP = LP * HP;
     HP *= HP;
@@ -380,8 +686,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_LPHPmorph(double omega,
     set_coef(a0, a1, a2, b0, b1, b2);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_APF(double omega, double Q)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_APF(double omega, double Q)
 {
     if ((omega < 0.0) || (omega > M_PI))
         set_coef(1, 0, 0, 1, 0, 0);
@@ -394,16 +700,18 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_APF(double omega, double
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_peakEQ(double omega, double BW, double gain)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_peakEQ(double omega, double BW,
+                                                                  double gain)
 {
     coeff_orfanidisEQ(omega, BW, Adapter::dbToLinear(storage, gain),
                       Adapter::dbToLinear(storage, gain * 0.5), 1);
 }
 
-template <typename DT, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<DT, BLOCK_SIZE, Adapter>::coeff_orfanidisEQ(double omega, double BW,
-                                                                     double G, double GB, double G0)
+template <typename DT, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<DT, BLOCK_SIZE, Adapter, P>::coeff_orfanidisEQ(double omega,
+                                                                        double BW, double G,
+                                                                        double GB, double G0)
 {
     // For the curious http://eceweb1.rutgers.edu/~orfanidi/ece521/hpeq.pdf appears to be the source
     // of this
@@ -459,14 +767,44 @@ inline void BiquadFilter<DT, BLOCK_SIZE, Adapter>::coeff_orfanidisEQ(double omeg
     }
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_same_as_last_time()
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_lowShelf(double omega, double Q,
+                                                                    double gain)
+{
+    double A = Adapter::dbToLinear(storage, gain * 0.5), sqA = sqrt(A);
+    double cosi = cos(omega), sinu = sin(omega), alpha = sinu / (2 * Q),
+           b0 = A * ((A + 1) - (A - 1) * cosi + 2 * sqA * alpha),
+           b1 = 2 * A * ((A - 1) - (A + 1) * cosi),
+           b2 = A * ((A + 1) - (A - 1) * cosi - 2 * sqA * alpha),
+           a0 = (A + 1) + (A - 1) * cosi + 2 * sqA * alpha, a1 = -2 * ((A - 1) + (A + 1) * cosi),
+           a2 = (A + 1) + (A - 1) * cosi - 2 * sqA * alpha;
+
+    set_coef(a0, a1, a2, b0, b1, b2);
+}
+
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_highShelf(double omega, double Q,
+                                                                     double gain)
+{
+    double A = Adapter::dbToLinear(storage, gain * 0.5), sqA = sqrt(A);
+    double cosi = cos(omega), sinu = sin(omega), alpha = sinu / (2 * Q),
+           b0 = A * ((A + 1) + (A - 1) * cosi + 2 * sqA * alpha),
+           b1 = -2 * A * ((A - 1) + (A + 1) * cosi),
+           b2 = A * ((A + 1) + (A - 1) * cosi - 2 * sqA * alpha),
+           a0 = (A + 1) - (A - 1) * cosi + 2 * sqA * alpha, a1 = 2 * ((A - 1) - (A + 1) * cosi),
+           a2 = (A + 1) - (A - 1) * cosi - 2 * sqA * alpha;
+
+    set_coef(a0, a1, a2, b0, b1, b2);
+}
+
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_same_as_last_time()
 {
     // If you want to change interpolation then set dv = 0 here
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_instantize()
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::coeff_instantize()
 {
     a1.instantize();
     a2.instantize();
@@ -475,9 +813,9 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::coeff_instantize()
     b2.instantize();
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::set_coef(double a0, double a1, double a2,
-                                                           double b0, double b1, double b2)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::set_coef(double a0, double a1, double a2,
+                                                              double b0, double b1, double b2)
 {
     double a0inv = 1 / a0;
 
@@ -486,6 +824,19 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::set_coef(double a0, double a1,
     b2 *= a0inv;
     a1 *= a0inv;
     a2 *= a0inv;
+
+    if constexpr (std::is_same_v<P, float>)
+    {
+        /*
+         * Rounding to float can push a pole near z = 1 onto or past the unit circle, so keep
+         * the rounded a1 and a2 inside the stability triangle |a2| < 1, |a1| < 1 + a2.
+         */
+        auto fa2 = std::clamp((float)a2, -std::nextafter(1.f, 0.f), std::nextafter(1.f, 0.f));
+        auto fa1lim = std::nextafter(1.f + fa2, 0.f);
+        a2 = fa2;
+        a1 = std::clamp((float)a1, -fa1lim, fa1lim);
+    }
+
     if (first_run)
     {
         this->a1.startValue(a1);
@@ -502,202 +853,65 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::set_coef(double a0, double a1,
     this->b2.newValue(b2);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block(float *data)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block(float *data)
 {
-    {
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            a1.process();
-            a2.process();
-            b0.process();
-            b1.process();
-            b2.process();
-
-            double input = data[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            data[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-    }
+    processMonoBlock(data, data);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
 inline void
-BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block_to(const float *__restrict const data,
-                                                       float *__restrict dataout)
+BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block_to(const float *__restrict const data,
+                                                          float *__restrict dataout)
 {
-    {
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            a1.process();
-            a2.process();
-            b0.process();
-            b1.process();
-            b2.process();
-
-            double input = data[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dataout[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-    }
+    processMonoBlock(data, dataout);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block_slowlag(float *__restrict dataL,
-                                                                        float *__restrict dataR)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void
+BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block_slowlag(float *__restrict dataL,
+                                                               float *__restrict dataR)
 {
-    {
-        a1.process();
-        a2.process();
-        b0.process();
-        b1.process();
-        b2.process();
-
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            double input = dataL[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dataL[k] = op;
-
-            input = dataR[k];
-            op = input * b0.v.d[0] + reg0.d[1];
-            reg0.d[1] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[1];
-            reg1.d[1] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dataR[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-        flush_denormal(reg0.d[1]);
-        flush_denormal(reg1.d[1]);
-    }
+    processStereoBlock<false>(
+        [dataL, dataR](size_t k) { return engine_t::pair(dataL[k], dataR[k]); },
+        [dataL, dataR](size_t k, const P *op) {
+            dataL[k] = op[0];
+            dataR[k] = op[1];
+        });
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block(float *dataL, float *dataR)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block(float *dataL, float *dataR)
 {
-    {
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            a1.process();
-            a2.process();
-            b0.process();
-            b1.process();
-            b2.process();
-
-            double input = dataL[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dataL[k] = op;
-
-            input = dataR[k];
-            op = input * b0.v.d[0] + reg0.d[1];
-            reg0.d[1] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[1];
-            reg1.d[1] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dataR[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-        flush_denormal(reg0.d[1]);
-        flush_denormal(reg1.d[1]);
-    }
+    processStereoBlock<true>(
+        [dataL, dataR](size_t k) { return engine_t::pair(dataL[k], dataR[k]); },
+        [dataL, dataR](size_t k, const P *op) {
+            dataL[k] = op[0];
+            dataR[k] = op[1];
+        });
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block_to(const float *const dataL,
-                                                                   const float *const dataR,
-                                                                   float *dstL, float *dstR)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block_to(const float *const dataL,
+                                                                      const float *const dataR,
+                                                                      float *dstL, float *dstR)
 {
-    {
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            a1.process();
-            a2.process();
-            b0.process();
-            b1.process();
-            b2.process();
-
-            double input = dataL[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dstL[k] = op;
-
-            input = dataR[k];
-            op = input * b0.v.d[0] + reg0.d[1];
-            reg0.d[1] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[1];
-            reg1.d[1] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            dstR[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-        flush_denormal(reg0.d[1]);
-        flush_denormal(reg1.d[1]);
-    }
+    processStereoBlock<true>(
+        [dataL, dataR](size_t k) { return engine_t::pair(dataL[k], dataR[k]); },
+        [dstL, dstR](size_t k, const P *op) {
+            dstL[k] = op[0];
+            dstR[k] = op[1];
+        });
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::process_block(double *data)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::process_block(double *data)
 {
-    {
-        int k;
-        for (k = 0; k < BLOCK_SIZE; k++)
-        {
-            a1.process();
-            a2.process();
-            b0.process();
-            b1.process();
-            b2.process();
-
-            double input = data[k];
-            double op;
-
-            op = input * b0.v.d[0] + reg0.d[0];
-            reg0.d[0] = input * b1.v.d[0] - a1.v.d[0] * op + reg1.d[0];
-            reg1.d[0] = input * b2.v.d[0] - a2.v.d[0] * op;
-
-            data[k] = op;
-        }
-        flush_denormal(reg0.d[0]);
-        flush_denormal(reg1.d[0]);
-    }
+    processMonoBlock(data, data);
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::setBlockSize(int bs)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline void BiquadFilter<D, BLOCK_SIZE, Adapter, P>::setBlockSize(int bs)
 {
     /*	a1.setBlockSize(bs);
             a2.setBlockSize(bs);
@@ -706,8 +920,8 @@ inline void BiquadFilter<D, BLOCK_SIZE, Adapter>::setBlockSize(int bs)
             b2.setBlockSize(bs);*/
 }
 
-template <typename D, size_t BLOCK_SIZE, typename Adapter>
-inline float BiquadFilter<D, BLOCK_SIZE, Adapter>::plot_magnitude(float f)
+template <typename D, size_t BLOCK_SIZE, typename Adapter, typename P>
+inline float BiquadFilter<D, BLOCK_SIZE, Adapter, P>::plot_magnitude(float f)
 {
     std::complex<double> ca0(1, 0), ca1(a1.v.d[0], 0), ca2(a2.v.d[0], 0), cb0(b0.v.d[0], 0),
         cb1(b1.v.d[0], 0), cb2(b2.v.d[0], 0);
@@ -16,10 +16,15 @@
 #ifndef INCLUDE_SST_FILTERS_BUTTERWORTHLPHP_H
 #define INCLUDE_SST_FILTERS_BUTTERWORTHLPHP_H
 
+#include <algorithm>
 #include <cmath>
 #include <array>
+#include <cassert>
 #include <numbers>
 
+#include "sst/basic-blocks/simd/setup.h"
+#include "PlanarQuadBlock.h"
+
 namespace sst::filters
 {
 
@@ -29,6 +34,37 @@ enum class ButterworthType
     Highpass
 };
 
+namespace details
+{
+// The damping of one second order stage of an order N Butterworth
+inline float butterworthStageQ(int order, int stage)
+{
+    const double theta = std::numbers::pi * (2.0 * stage + 1.0) / (2.0 * order);
+    return static_cast<float>(2.0 * std::cos(theta));
+}
+
+// and of all of them
+template <int N> inline std::array<float, N / 2> butterworthQ()
+{
+    std::array<float, N / 2> q{};
+    for (int i = 0; i < N / 2; ++i)
+        q[i] = butterworthStageQ(N, i);
+    return q;
+}
+
+// and the prewarped integrator gain for a cutoff, clamped to a sensible range
+inline float butterworthG(float cutoffHz, float sampleRate)
+{
+    const float fcMax = 0.49f * sampleRate;
+    if (cutoffHz > fcMax)
+        cutoffHz = fcMax;
+    if (cutoffHz < 1.0f)
+        cutoffHz = 1.0f;
+
+    return std::tan(std::numbers::pi_v<float> * cutoffHz / sampleRate);
+}
+} // namespace details
+
 /**
  * Cascaded TPT state-variable Butterworth filter, even orders only.
  * N is the filter order (poles); attenuation is N*6 dB/oct.
@@ -44,13 +80,7 @@ template <int N, ButterworthType Type> class Butterworth
 
     void setCutoffAndSampleRate(float cutoffHz, float sampleRate)
     {
-        const float fcMax = 0.49f * sampleRate;
-        if (cutoffHz > fcMax)
-            cutoffHz = fcMax;
-        if (cutoffHz < 1.0f)
-            cutoffHz = 1.0f;
-
-        const float g = std::tan(std::numbers::pi_v<float> * cutoffHz / sampleRate);
+        const float g = details::butterworthG(cutoffHz, sampleRate);
         gCoeff_ = g;
 
         for (int i = 0; i < kStages; ++i)
@@ -156,29 +186,350 @@ template <int N, ButterworthType Type> class Butterworth
     }
 
   private:
-    static std::array<float, kStages> computeQ()
+    const std::array<float, kStages> kQ_ = details::butterworthQ<N>();
+
+    std::array<float, kStages> a_{}, kPlusG_{};
+    float gCoeff_ = 0.0f;
+
+    std::array<float, kStages> z1_{}, z2_{};
+    std::array<float, kStages> z1L_{}, z2L_{}, z1R_{}, z2R_{};
+};
+
+namespace details
+{
+/*
+ * The SIMD core of the multichannel cascades: up to MaxStages stages on up to MaxChannels
+ * channels, four channels per register with the coefficients shared. The stage count is an
+ * argument so that the fixed and runtime order filters can share this.
+ */
+template <ButterworthType Type, int MaxStages, int MaxChannels> struct ButterworthQuadCascade
+{
+    static_assert(MaxChannels >= 1, "MaxChannels must be at least one");
+    static constexpr int kQuads = (MaxChannels + 3) / 4;
+    static constexpr bool kIsHP = (Type == ButterworthType::Highpass);
+
+    void setCoefficients(float g, const float *q, int nStages)
     {
-        std::array<float, kStages> q{};
+        assert(nStages >= 1 && nStages <= MaxStages);
+        gCoeff_ = SIMD_MM(set1_ps)(g);
+
+        for (int i = 0; i < nStages; ++i)
+        {
+            a_[i] = SIMD_MM(set1_ps)(1.0f / (1.0f + g * (g + q[i])));
+            kPlusG_[i] = SIMD_MM(set1_ps)(q[i] + g);
+        }
+    }
+
+    inline SIMD_M128 processQuad(SIMD_M128 x, int quad, int nStages)
+    {
+        assert(quad >= 0 && quad < kQuads);
+        auto *z1 = z1_[quad];
+        auto *z2 = z2_[quad];
+        const auto g = gCoeff_;
+
+        auto sig = x;
+        for (int i = 0; i < nStages; ++i)
+        {
+            const auto hp = SIMD_MM(mul_ps)(
+                SIMD_MM(sub_ps)(SIMD_MM(sub_ps)(sig, SIMD_MM(mul_ps)(kPlusG_[i], z1[i])), z2[i]),
+                a_[i]);
+            const auto bp = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, hp), z1[i]);
+            const auto lp = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, bp), z2[i]);
+            z1[i] = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, hp), bp);
+            z2[i] = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, bp), lp);
+
+            if constexpr (kIsHP)
+                sig = hp;
+            else
+                sig = lp;
+        }
+        return sig;
+    }
+
+    void processBlock(const float *const *in, float *const *out, int nChannels, int numSamples,
+                      int nStages)
+    {
+        assert(nChannels >= 0 && nChannels <= MaxChannels);
+        const int nQuads = (nChannels + 3) / 4;
+        auto step = [this, nQuads, nStages](SIMD_M128 *v) {
+            for (int q = 0; q < nQuads; ++q)
+                v[q] = processQuad(v[q], q, nStages);
+        };
+        processPlanarQuadBlock<kQuads>(in, out, nChannels, nQuads, numSamples, step);
+    }
+
+    void reset()
+    {
+        for (int q = 0; q < kQuads; ++q)
+        {
+            for (int i = 0; i < MaxStages; ++i)
+            {
+                z1_[q][i] = SIMD_MM(setzero_ps)();
+                z2_[q][i] = SIMD_MM(setzero_ps)();
+            }
+        }
+    }
+
+    SIMD_M128 a_[MaxStages]{}, kPlusG_[MaxStages]{};
+    SIMD_M128 gCoeff_{};
+
+    SIMD_M128 z1_[kQuads][MaxStages], z2_[kQuads][MaxStages];
+};
+} // namespace details
+
+/**
+ * The same cascade on up to MaxChannels channels, four at a time in SIMD registers with the
+ * coefficients shared. Use it for surround buses, anti aliasing on many outputs and the
+ * like; processQuad also takes two stereo pairs or any other four lanes directly.
+ *
+ * Each channel's output is that of a Butterworth with the same settings, to rounding.
+ */
+template <int N, ButterworthType Type, int MaxChannels = 4> class MultichannelButterworth
+{
+    static_assert(N >= 2 && N % 2 == 0, "N must be a positive even integer");
+    static constexpr int kStages = N / 2;
+
+  public:
+    MultichannelButterworth() { reset(); }
+
+    void setCutoffAndSampleRate(float cutoffHz, float sampleRate)
+    {
+        cascade_.setCoefficients(details::butterworthG(cutoffHz, sampleRate), kQ_.data(),
+                                 kStages);
+    }
+
+    /** One sample of the four channels of a quad, in lanes 0 to 3 */
+    inline SIMD_M128 processQuad(SIMD_M128 x, int quad = 0)
+    {
+        return cascade_.processQuad(x, quad, kStages);
+    }
+
+    /** Filter nChannels planar channels in place */
+    void processBlock(float *const *channels, int nChannels, int numSamples)
+    {
+        processBlock(channels, channels, nChannels, numSamples);
+    }
+
+    void processBlock(const float *const *in, float *const *out, int nChannels, int numSamples)
+    {
+        cascade_.processBlock(in, out, nChannels, numSamples, kStages);
+    }
+
+    void reset() { cascade_.reset(); }
+
+  private:
+    const std::array<float, kStages> kQ_ = details::butterworthQ<N>();
+    details::ButterworthQuadCascade<Type, kStages, MaxChannels> cascade_;
+};
+
+/**
+ * A multichannel Butterworth whose order is chosen at runtime, for slope menus. Every even
+ * order up to maxOrder shares the one preallocated set of stages, so changing order is a
+ * coefficient update and a reset rather than a different type.
+ *
+ * At a given order each channel's output is that of Butterworth<order, Type>, to rounding.
+ */
+template <ButterworthType Type, int MaxChannels = 4> class RuntimeButterworth
+{
+  public:
+    static constexpr int maxOrder{16};
+
+    RuntimeButterworth() { setOrder(2); }
+
+    /**
+     * Set an even order from 2 to maxOrder. The new stages start from silence, so do this
+     * where a discontinuity will not be heard, or crossfade.
+     */
+    void setOrder(int order)
+    {
+        assert(order >= 2 && order <= maxOrder && order % 2 == 0);
+        order_ = std::clamp(order & ~1, 2, maxOrder);
+        for (int i = 0; i < order_ / 2; ++i)
+            q_[i] = details::butterworthStageQ(order_, i);
+        updateCoefficients();
+        cascade_.reset();
+    }
+    int getOrder() const { return order_; }
+
+    void setCutoffAndSampleRate(float cutoffHz, float sampleRate)
+    {
+        g_ = details::butterworthG(cutoffHz, sampleRate);
+        updateCoefficients();
+    }
+
+    /** One sample of the four channels of a quad, in lanes 0 to 3 */
+    inline SIMD_M128 processQuad(SIMD_M128 x, int quad = 0)
+    {
+        return cascade_.processQuad(x, quad, order_ / 2);
+    }
+
+    void processBlock(float *const *channels, int nChannels, int numSamples)
+    {
+        processBlock(channels, channels, nChannels, numSamples);
+    }
+
+    void processBlock(const float *const *in, float *const *out, int nChannels, int numSamples)
+    {
+        cascade_.processBlock(in, out, nChannels, numSamples, order_ / 2);
+    }
+
+    void reset() { cascade_.reset(); }
+
+  private:
+    void updateCoefficients() { cascade_.setCoefficients(g_, q_.data(), order_ / 2); }
+
+    int order_{2};
+    float g_{0.f};
+    std::array<float, maxOrder / 2> q_{};
+    details::ButterworthQuadCascade<Type, maxOrder / 2, MaxChannels> cascade_;
+};
+
+/**
+ * A mono Butterworth cascade with the stages pipelined across SIMD lanes.
+ *
+ * In a plain cascade each stage waits on the one before, so a high order filter is a chain
+ * of dependent steps per sample. Here, as in FastTiltNoiseFilter, stage k works on the sample
+ * stage k - 1 finished on the previous step, so all the stages run at once in SIMD registers
+ * and the output is the plain cascade's, to rounding, delayed by exactly `latency` samples.
+ * Use it where a fixed latency is fine, and processOffline to filter a whole buffer with the
+ * latency removed.
+ */
+template <int N, ButterworthType Type> class PipelinedButterworth
+{
+    static_assert(N >= 2 && N % 2 == 0, "N must be a positive even integer");
+    static constexpr int kStages = N / 2;
+    static constexpr int kVecs = (kStages + 3) / 4;
+    static constexpr int kLastLane = (kStages - 1) % 4;
+    static constexpr bool kIsHP = (Type == ButterworthType::Highpass);
+
+  public:
+    /** The delay, in samples, relative to the equivalent Butterworth */
+    static constexpr int latency{kStages - 1};
+
+    PipelinedButterworth() { reset(); }
+
+    void setCutoffAndSampleRate(float cutoffHz, float sampleRate)
+    {
+        const float g = details::butterworthG(cutoffHz, sampleRate);
+        gCoeff_ = SIMD_MM(set1_ps)(g);
+
+        // Lanes past the last stage get zero coefficients, so they stay silent
+        float a alignas(16)[kVecs * 4]{}, kpg alignas(16)[kVecs * 4]{};
         for (int i = 0; i < kStages; ++i)
         {
-            const double theta = std::numbers::pi * (2.0 * i + 1.0) / (2.0 * N);
-            q[i] = static_cast<float>(2.0 * std::cos(theta));
+            a[i] = 1.0f / (1.0f + g * (g + kQ_[i]));
+            kpg[i] = kQ_[i] + g;
+        }
+        for (int v = 0; v < kVecs; ++v)
+        {
+            a_[v] = SIMD_MM(load_ps)(a + 4 * v);
+            kPlusG_[v] = SIMD_MM(load_ps)(kpg + 4 * v);
         }
-        return q;
     }
 
-    const std::array<float, kStages> kQ_ = computeQ();
+    inline float processSample(float x)
+    {
+        // Each stage takes the previous output of the stage before, and the first takes x
+        SIMD_M128 sig[kVecs];
+        sig[0] = SIMD_MM(move_ss)(SIMD_MM(shuffle_ps)(y_[0], y_[0], SIMD_MM_SHUFFLE(2, 1, 0, 0)),
+                                  SIMD_MM(set_ss)(x));
+        for (int v = 1; v < kVecs; ++v)
+            sig[v] = SIMD_MM(move_ss)(
+                SIMD_MM(shuffle_ps)(y_[v], y_[v], SIMD_MM_SHUFFLE(2, 1, 0, 0)),
+                SIMD_MM(shuffle_ps)(y_[v - 1], y_[v - 1], SIMD_MM_SHUFFLE(3, 3, 3, 3)));
+
+        const auto g = gCoeff_;
+        for (int v = 0; v < kVecs; ++v)
+        {
+            const auto hp = SIMD_MM(mul_ps)(
+                SIMD_MM(sub_ps)(SIMD_MM(sub_ps)(sig[v], SIMD_MM(mul_ps)(kPlusG_[v], z1_[v])),
+                                z2_[v]),
+                a_[v]);
+            const auto bp = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, hp), z1_[v]);
+            const auto lp = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, bp), z2_[v]);
+            z1_[v] = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, hp), bp);
+            z2_[v] = SIMD_MM(add_ps)(SIMD_MM(mul_ps)(g, bp), lp);
 
-    std::array<float, kStages> a_{}, kPlusG_{};
-    float gCoeff_ = 0.0f;
+            if constexpr (kIsHP)
+                y_[v] = hp;
+            else
+                y_[v] = lp;
+        }
 
-    std::array<float, kStages> z1_{}, z2_{};
-    std::array<float, kStages> z1L_{}, z2L_{}, z1R_{}, z2R_{};
+        const auto &last = y_[kVecs - 1];
+        return SIMD_MM(cvtss_f32)(SIMD_MM(shuffle_ps)(
+            last, last, SIMD_MM_SHUFFLE(kLastLane, kLastLane, kLastLane, kLastLane)));
+    }
+
+    void processBlock(float *data, int numSamples)
+    {
+        for (int n = 0; n < numSamples; ++n)
+            data[n] = processSample(data[n]);
+    }
+
+    void processBlock(const float *in, float *out, int numSamples)
+    {
+        for (int n = 0; n < numSamples; ++n)
+            out[n] = processSample(in[n]);
+    }
+
+    /**
+     * Reset and filter a complete buffer, running on past the end to drain the pipeline so
+     * that out[n] lines up with in[n]. in and out may be the same buffer.
+     */
+    void processOffline(const float *in, float *out, int numSamples)
+    {
+        reset();
+        for (int n = 0; n < numSamples; ++n)
+        {
+            auto y = processSample(in[n]);
+            if (n >= latency)
+                out[n - latency] = y;
+        }
+        // Drain the whole pipeline, since a buffer shorter than the latency has not reached
+        // the output at all yet
+        for (int n = numSamples; n < numSamples + latency; ++n)
+        {
+            auto y = processSample(0.f);
+            if (n >= latency)
+                out[n - latency] = y;
+        }
+    }
+
+    void reset()
+    {
+        for (int v = 0; v < kVecs; ++v)
+        {
+            z1_[v] = SIMD_MM(setzero_ps)();
+            z2_[v] = SIMD_MM(setzero_ps)();
+            y_[v] = SIMD_MM(setzero_ps)();
+        }
+    }
+
+  private:
+    const std::array<float, kStages> kQ_ = details::butterworthQ<N>();
+
+    SIMD_M128 a_[kVecs]{}, kPlusG_[kVecs]{};
+    SIMD_M128 gCoeff_{};
+
+    // the stage states, and each stage's output from the last step
+    SIMD_M128 z1_[kVecs], z2_[kVecs], y_[kVecs];
 };
 
 // Convenience aliases
 template <int N> using ButterworthLP = Butterworth<N, ButterworthType::Lowpass>;
 template <int N> using ButterworthHP = Butterworth<N, ButterworthType::Highpass>;
+template <int N, int MaxChannels = 4>
+using MultichannelButterworthLP = MultichannelButterworth<N, ButterworthType::Lowpass, MaxChannels>;
+template <int N, int MaxChannels = 4>
+using MultichannelButterworthHP =
+    MultichannelButterworth<N, ButterworthType::Highpass, MaxChannels>;
+template <int MaxChannels = 4>
+using RuntimeButterworthLP = RuntimeButterworth<ButterworthType::Lowpass, MaxChannels>;
+template <int MaxChannels = 4>
+using RuntimeButterworthHP = RuntimeButterworth<ButterworthType::Highpass, MaxChannels>;
+template <int N> using PipelinedButterworthLP = PipelinedButterworth<N, ButterworthType::Lowpass>;
+template <int N> using PipelinedButterworthHP = PipelinedButterworth<N, ButterworthType::Highpass>;
 
 } // namespace sst::filters
 
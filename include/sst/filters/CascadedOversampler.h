@@ -0,0 +1,188 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_CASCADEDOVERSAMPLER_H
+#define INCLUDE_SST_FILTERS_CASCADEDOVERSAMPLER_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+
+#include "HalfRateFilter.h"
+
+namespace sst::filters::HalfRate
+{
+
+struct StageSettings
+{
+    uint32_t M;
+    bool steep;
+};
+
+/**
+ * The half rate filter settings for stage `stage` of an oversampling cascade, where stage 0
+ * sits against the host rate. That stage needs the steep transition to keep the host band
+ * flat. Each later stage only has to keep its images away from a band which is a smaller
+ * fraction of its own rate, so it gets away with a shorter, softer filter.
+ */
+inline constexpr StageSettings cascadeStageSettings(int stage)
+{
+    switch (stage)
+    {
+    case 0:
+        return {6, true};
+    case 1:
+        return {4, false};
+    default:
+        return {2, false};
+    }
+}
+
+/**
+ * A stereo up/down sampler by `factor` (2 to 32, a power of two) built from a chain of
+ * HalfRateFilter stages using cascadeStageSettings.
+ *
+ * The stages and a single ping-pong scratch buffer for the intermediate rates are owned here,
+ * so nothing is allocated while processing. Blocks of any multiple of 4 host samples are
+ * accepted and are run in chunks sized so that no stage exceeds hr_BLOCK_SIZE. As with
+ * HalfRateFilter, buffers must be 16 byte aligned.
+ *
+ * Upsampling is full scale, so an upsample followed by a downsample has unity gain and
+ * delays by latency() host samples.
+ */
+template <int factor> struct CascadedOversampler
+{
+    static_assert(factor >= 2 && factor <= 32 && (factor & (factor - 1)) == 0,
+                  "CascadedOversampler factor must be a power of two from 2 to 32");
+
+    static constexpr int nStages{[]() {
+        int res{0};
+        while ((1 << res) < factor)
+            res++;
+        return res;
+    }()};
+    // host samples per chunk. A multiple of 4 for every allowed factor
+    static constexpr int chunkSize{(int)hr_BLOCK_SIZE / factor};
+
+    CascadedOversampler() : stages(makeStages(std::make_index_sequence<nStages>())) {}
+
+    /**
+     * Upsample nsamples host samples from inL/inR into nsamples * factor samples in
+     * outL/outR.
+     */
+    void upsample(float *inL, float *inR, float *outL, float *outR, int nsamples)
+    {
+        assert(nsamples % 4 == 0);
+        for (int c = 0; c < nsamples; c += chunkSize)
+        {
+            int n = std::min(chunkSize, nsamples - c);
+            float *srcL = inL + c, *srcR = inR + c;
+            for (int s = 0; s < nStages; ++s)
+            {
+                n <<= 1;
+                float *dstL, *dstR;
+                if (s == nStages - 1)
+                {
+                    dstL = outL + c * factor;
+                    dstR = outR + c * factor;
+                }
+                else
+                {
+                    dstL = scratch[s & 1][0];
+                    dstR = scratch[s & 1][1];
+                }
+                stages[s].up.process_block_U2_fullscale(srcL, srcR, dstL, dstR, n);
+                srcL = dstL;
+                srcR = dstR;
+            }
+        }
+    }
+
+    /**
+     * Downsample nsamples * factor samples from inL/inR into nsamples host samples in
+     * outL/outR.
+     */
+    void downsample(float *inL, float *inR, float *outL, float *outR, int nsamples)
+    {
+        assert(nsamples % 4 == 0);
+        for (int c = 0; c < nsamples; c += chunkSize)
+        {
+            int n = std::min(chunkSize, nsamples - c) * factor;
+            float *srcL = inL + c * factor, *srcR = inR + c * factor;
+            for (int s = nStages - 1; s >= 0; --s)
+            {
+                float *dstL, *dstR;
+                if (s == 0)
+                {
+                    dstL = outL + c;
+                    dstR = outR + c;
+                }
+                else
+                {
+                    dstL = scratch[s & 1][0];
+                    dstR = scratch[s & 1][1];
+                }
+                stages[s].down.process_block_D2(srcL, srcR, n, dstL, dstR);
+                srcL = dstL;
+                srcR = dstR;
+                n >>= 1;
+            }
+        }
+    }
+
+    /**
+     * The low frequency delay of an upsample followed by a downsample, in host samples.
+     */
+    float latency() const
+    {
+        float res{0.f};
+        for (int s = 0; s < nStages; ++s)
+            res += stages[s].up.latency() / (1 << s);
+        return res;
+    }
+
+    void reset()
+    {
+        for (auto &s : stages)
+        {
+            s.up.reset();
+            s.down.reset();
+        }
+    }
+
+  private:
+    struct Stage
+    {
+        explicit Stage(StageSettings st) : up(st.M, st.steep), down(st.M, st.steep) {}
+
+        HalfRateFilter up, down;
+    };
+
+    template <size_t... I>
+    static std::array<Stage, nStages> makeStages(std::index_sequence<I...>)
+    {
+        return {Stage(cascadeStageSettings(I))...};
+    }
+
+    std::array<Stage, nStages> stages;
+
+    // Intermediate rates alternate between these two, so the largest, just below the output
+    // rate, is hr_BLOCK_SIZE / 2 samples per channel
+    float scratch alignas(16)[2][2][hr_BLOCK_SIZE / 2];
+};
+} // namespace sst::filters::HalfRate
+
+#endif // SST_FILTERS_CASCADEDOVERSAMPLER_H
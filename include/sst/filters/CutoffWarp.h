@@ -19,6 +19,7 @@
 #include "FilterCoefficientMaker.h"
 #include "sst/basic-blocks/dsp/FastMath.h"
 #include "sst/basic-blocks/dsp/Clippers.h"
+#include "Nonlinearity.h"
 
 /**
  * This namespace contains an adaptation of the filter found at
@@ -90,6 +91,7 @@ static inline SIMD_M128 ojd_waveshaper_ps(const SIMD_M128 x) noexcept
         SIMD_MM(and_ps)(maskMid, vMid));
 }
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 doNLFilter(const SIMD_M128 input, const SIMD_M128 a1, const SIMD_M128 a2,
                                    const SIMD_M128 b0, const SIMD_M128 b1, const SIMD_M128 b2,
                                    const SIMD_M128 makeup, const int sat, SIMD_M128 &z1,
@@ -110,7 +112,7 @@ static inline SIMD_M128 doNLFilter(const SIMD_M128 input, const SIMD_M128 a1, co
         nf = ojd_waveshaper_ps(out);
         break;
     default: // SAT_TANH; the removed SAT_SINE and others are also caught here
-        nf = basic_blocks::dsp::fasttanhSSEclamped(out);
+        nf = Nonlinearity::tanh<accuracy>(out);
         break;
     }
 
@@ -233,7 +235,7 @@ void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float freq, fl
     cm->FromDirect(C);
 }
 
-template <FilterSubType subtype>
+template <FilterSubType subtype, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 {
     // lower 2 bits of subtype is the stage count
@@ -244,9 +246,9 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
     // n.b. stages are zero-indexed so use <=
     for (int stage = 0; stage <= stages; ++stage)
     {
-        input =
-            doNLFilter(input, f->C[nlf_a1], f->C[nlf_a2], f->C[nlf_b0], f->C[nlf_b1], f->C[nlf_b2],
-                       f->C[nlf_makeup], sat, f->R[nlf_z1 + stage * 2], f->R[nlf_z2 + stage * 2]);
+        input = doNLFilter<accuracy>(input, f->C[nlf_a1], f->C[nlf_a2], f->C[nlf_b0], f->C[nlf_b1],
+                                     f->C[nlf_b2], f->C[nlf_makeup], sat, f->R[nlf_z1 + stage * 2],
+                                     f->R[nlf_z2 + stage * 2]);
     }
 
     for (int i = 0; i < n_nlf_coeff; ++i)
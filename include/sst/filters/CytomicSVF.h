@@ -43,6 +43,7 @@
 #endif
 
 #include "sst/basic-blocks/dsp/FastMath.h"
+#include "PlanarQuadBlock.h"
 
 #include <complex>
 
@@ -165,6 +166,29 @@ struct CytomicSVF
         setCoeffPostGK(mode, SETALL(bellShelfAmp));
     }
 
+    /*
+     * Fully per lane, with a mode, freq, res and bellShelfAmp for each of the four lanes and
+     * one fasttanSSE for all four, so four voices can each run their own EQ band in one
+     * filter. A null bellShelfAmp is unity in every lane.
+     */
+    void setCoeff(std::array<Mode, 4> mode, const float *freq, const float *res, float srInv,
+                  const float *bellShelfAmp = nullptr)
+    {
+        float co alignas(16)[4], kl alignas(16)[4], al alignas(16)[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            co[i] = std::clamp(freq[i] * srInv, 0.f, 0.499f); // stable until nyquist
+            al[i] = bellShelfAmp ? std::max(bellShelfAmp[i], 0.001f) : 1.f;
+            kl[i] = 2.f - 2.f * std::clamp(res[i], 0.f, 0.98f);
+            if (mode[i] == Mode::Bell)
+                kl[i] /= al[i];
+        }
+        g = sst::basic_blocks::dsp::fasttanSSE(MUL(SETALL(M_PI), SIMD_MM(load_ps)(co)));
+        k = SIMD_MM(load_ps)(kl);
+
+        setCoeffPostGK(mode, SIMD_MM(load_ps)(al));
+    }
+
     // quad version for use in the shepard phaser. Somewhat simplified to save a couple cycles
     // but easy to expand to match the mono/stereo versions if we ever want to.
     void setCoeffQuadBandpass(float *freq, float res, float srInv)
@@ -411,105 +435,37 @@ struct CytomicSVF
     template <int blockSize>
     void setCoeffForBlock(Mode mode, float freq, float res, float srInv, float bellShelfAmp = 1.f)
     {
-        // Preserve the prior values
-        SIMD_M128 a1_prior = a1;
-        SIMD_M128 a2_prior = a2;
-        SIMD_M128 a3_prior = a3;
-
-        SIMD_M128 m0_prior = m0;
-        SIMD_M128 m1_prior = m1;
-        SIMD_M128 m2_prior = m2;
-
-        // calculate the new values
-        setCoeff(mode, freq, res, srInv, bellShelfAmp);
-
-        // If its the first time around snap them
-        if (firstBlock)
-        {
-            a1_prior = a1;
-            a2_prior = a2;
-            a3_prior = a3;
-            m0_prior = m0;
-            m1_prior = m1;
-            m2_prior = m2;
-            firstBlock = false;
-        }
-
-        // then for each one calculate the change across the block
-        static constexpr float obsf = 1.f / blockSize;
-        auto obs = SETALL(obsf);
-
-        // and set the changeup, and reset as to the prior value so we move in the block
-        da1 = MUL(SUB(a1, a1_prior), obs);
-        a1 = a1_prior;
-
-        da2 = MUL(SUB(a2, a2_prior), obs);
-        a2 = a2_prior;
-
-        da3 = MUL(SUB(a3, a3_prior), obs);
-        a3 = a3_prior;
-
-        dm0 = MUL(SUB(m0, m0_prior), obs);
-        m0 = m0_prior;
-
-        dm1 = MUL(SUB(m1, m1_prior), obs);
-        m1 = m1_prior;
-
-        dm2 = MUL(SUB(m2, m2_prior), obs);
-        m2 = m2_prior;
+        smoothCoeffsForBlock<blockSize>([&]() { setCoeff(mode, freq, res, srInv, bellShelfAmp); });
     }
 
-    // it's a bit annoying this is a copy but I am sure a clever future me will do better
     template <int blockSize>
     void setCoeffForBlock(Mode mode, float freqL, float freqR, float resL, float resR, float srInv,
                           float bellShelfAmpL, float bellShelfAmpR)
     {
-        SIMD_M128 a1_prior = a1;
-        SIMD_M128 a2_prior = a2;
-        SIMD_M128 a3_prior = a3;
-
-        SIMD_M128 m0_prior = m0;
-        SIMD_M128 m1_prior = m1;
-        SIMD_M128 m2_prior = m2;
-
-        setCoeff(mode, freqL, freqR, resL, resR, srInv, bellShelfAmpL, bellShelfAmpR);
-
-        if (firstBlock)
-        {
-            a1_prior = a1;
-            a2_prior = a2;
-            a3_prior = a3;
-            m0_prior = m0;
-            m1_prior = m1;
-            m2_prior = m2;
-            firstBlock = false;
-        }
-
-        static constexpr float obsf = 1.f / blockSize;
-        auto obs = SETALL(obsf);
-
-        da1 = MUL(SUB(a1, a1_prior), obs);
-        a1 = a1_prior;
-
-        da2 = MUL(SUB(a2, a2_prior), obs);
-        a2 = a2_prior;
-
-        da3 = MUL(SUB(a3, a3_prior), obs);
-        a3 = a3_prior;
-
-        dm0 = MUL(SUB(m0, m0_prior), obs);
-        m0 = m0_prior;
-
-        dm1 = MUL(SUB(m1, m1_prior), obs);
-        m1 = m1_prior;
+        smoothCoeffsForBlock<blockSize>([&]() {
+            setCoeff(mode, freqL, freqR, resL, resR, srInv, bellShelfAmpL, bellShelfAmpR);
+        });
+    }
 
-        dm2 = MUL(SUB(m2, m2_prior), obs);
-        m2 = m2_prior;
+    template <int blockSize>
+    void setCoeffForBlock(std::array<Mode, 4> mode, const float *freq, const float *res,
+                          float srInv, const float *bellShelfAmp = nullptr)
+    {
+        smoothCoeffsForBlock<blockSize>([&]() { setCoeff(mode, freq, res, srInv, bellShelfAmp); });
     }
 
-    // it's a bit annoying this is another copy but hey whatcha gonna do
     template <int blockSize> void setCoeffForBlockQuadBandpass(float *freq, float res, float srInv)
     {
+        smoothCoeffsForBlock<blockSize>([&]() { setCoeffQuadBandpass(freq, res, srInv); });
+    }
+
+    /*
+     * Run a setCoeff variant and turn the result into a per sample change across the block,
+     * leaving the coefficients at their prior values so processBlockStep moves towards it.
+     */
+    template <int blockSize, typename F> void smoothCoeffsForBlock(F &&calculateCoeffs)
+    {
+        // Preserve the prior values
         SIMD_M128 a1_prior = a1;
         SIMD_M128 a2_prior = a2;
         SIMD_M128 a3_prior = a3;
@@ -518,8 +474,10 @@ struct CytomicSVF
         SIMD_M128 m1_prior = m1;
         SIMD_M128 m2_prior = m2;
 
-        setCoeffQuadBandpass(freq, res, srInv);
+        // calculate the new values
+        calculateCoeffs();
 
+        // If its the first time around snap them
         if (firstBlock)
         {
             a1_prior = a1;
@@ -531,9 +489,11 @@ struct CytomicSVF
             firstBlock = false;
         }
 
+        // then for each one calculate the change across the block
         static constexpr float obsf = 1.f / blockSize;
         auto obs = SETALL(obsf);
 
+        // and set the changeup, and reset as to the prior value so we move in the block
         da1 = MUL(SUB(a1, a1_prior), obs);
         a1 = a1_prior;
 
@@ -642,6 +602,107 @@ struct CytomicSVF
 #undef SETALL
 };
 
+/**
+ * CytomicSVF8 runs eight SVF channels, either two stereo pairs or eight mono channels, for
+ * phasers, EQs and banks of bandpasses. The eight lanes are held as two CytomicSVFs which
+ * step together, so the two halves give the processor two independent dependency chains to
+ * overlap rather than one.
+ *
+ * The shared coefficient calls compute once and copy to both halves. For anything else, like
+ * a different stereo setting per pair, set `svf[0]` (channels 0 to 3) and `svf[1]` (channels
+ * 4 to 7) directly with any of the CytomicSVF calls.
+ */
+struct CytomicSVF8
+{
+    using Mode = CytomicSVF::Mode;
+
+    CytomicSVF svf[2];
+
+    void setCoeff(Mode mode, float freq, float res, float srInv, float bellShelfAmp = 1.f)
+    {
+        svf[0].setCoeff(mode, freq, res, srInv, bellShelfAmp);
+        svf[1].fetchCoeffs(svf[0]);
+    }
+
+    /*
+     * Eight bandpasses at the eight frequencies in freq
+     */
+    void setCoeffOctBandpass(float *freq, float res, float srInv)
+    {
+        svf[0].setCoeffQuadBandpass(freq, res, srInv);
+        svf[1].setCoeffQuadBandpass(freq + 4, res, srInv);
+    }
+
+    template <int blockSize>
+    void setCoeffForBlock(Mode mode, float freq, float res, float srInv, float bellShelfAmp = 1.f)
+    {
+        svf[0].setCoeffForBlock<blockSize>(mode, freq, res, srInv, bellShelfAmp);
+        svf[1].fetchCoeffs(svf[0]);
+        svf[1].dm0 = svf[0].dm0;
+        svf[1].dm1 = svf[0].dm1;
+        svf[1].dm2 = svf[0].dm2;
+        svf[1].firstBlock = false;
+    }
+
+    template <int blockSize> void setCoeffForBlockOctBandpass(float *freq, float res, float srInv)
+    {
+        svf[0].setCoeffForBlockQuadBandpass<blockSize>(freq, res, srInv);
+        svf[1].setCoeffForBlockQuadBandpass<blockSize>(freq + 4, res, srInv);
+    }
+
+    template <int blockSize> void retainCoeffForBlock()
+    {
+        svf[0].retainCoeffForBlock<blockSize>();
+        svf[1].retainCoeffForBlock<blockSize>();
+    }
+
+    /*
+     * Step channels 0-3 in lo and 4-7 in hi
+     */
+    static void stepSSE(CytomicSVF8 &that, SIMD_M128 &lo, SIMD_M128 &hi)
+    {
+        lo = CytomicSVF::stepSSE(that.svf[0], lo);
+        hi = CytomicSVF::stepSSE(that.svf[1], hi);
+    }
+
+    void processBlockStep(SIMD_M128 &lo, SIMD_M128 &hi)
+    {
+        stepSSE(*this, lo, hi);
+        advanceCoeffs(svf[0]);
+        advanceCoeffs(svf[1]);
+    }
+
+    /*
+     * Process nChannels planar channels, up to eight, across a block with smoothing. The
+     * channels are transposed four samples at a time so each step is a single register per
+     * half.
+     */
+    template <int blockSize>
+    void processBlock(const float *const *in, float *const *out, int nChannels = 8)
+    {
+        assert(nChannels >= 0 && nChannels <= 8);
+        details::processPlanarQuadBlock<2>(in, out, nChannels, 2, blockSize,
+                                           [this](SIMD_M128 *v) { processBlockStep(v[0], v[1]); });
+    }
+
+    void init()
+    {
+        svf[0].init();
+        svf[1].init();
+    }
+
+  protected:
+    static void advanceCoeffs(CytomicSVF &s)
+    {
+        s.a1 = SIMD_MM(add_ps)(s.a1, s.da1);
+        s.a2 = SIMD_MM(add_ps)(s.a2, s.da2);
+        s.a3 = SIMD_MM(add_ps)(s.a3, s.da3);
+        s.m1 = SIMD_MM(add_ps)(s.m1, s.dm1);
+        s.m2 = SIMD_MM(add_ps)(s.m2, s.dm2);
+        s.m0 = SIMD_MM(add_ps)(s.m0, s.dm0);
+    }
+};
+
 /**
  * CytomicSVFGainAt returns the linear amplitude gain for a given mode cutoff res amp at a given
  * frequency. It is based on the complex analytic formulas in the above referenced PDF at page 12
@@ -0,0 +1,320 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_EQCHAIN_H
+#define INCLUDE_SST_FILTERS_EQCHAIN_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+#include "sst/basic-blocks/simd/setup.h"
+
+#include "BiquadFilter.h"
+
+namespace sst::filters::Biquad
+{
+/**
+ * A cascade of N smoothed stereo biquads, for parametric EQs.
+ *
+ * Chaining N BiquadFilters walks the buffer N times and runs N sets of scalar coefficient
+ * lags. An EQChain designs each band with BiquadFilter's own coefficient math, but keeps the
+ * coefficients of every band in structure of arrays form, so a sample advances the lags of two
+ * bands per packed step and then runs the whole cascade, left and right together, before
+ * moving on. Bypassed bands are skipped entirely.
+ *
+ * Given the same coefficient calls the output matches the equivalent BiquadFilters in series,
+ * except that the signal stays in double between bands rather than rounding to float. A band
+ * which has not been designed since construction or the last suspend passes the signal
+ * unchanged, so a chain can have more bands than are in use.
+ *
+ * ```cpp
+ *     auto eq = EQChain<Storage, BLOCK_SIZE, 8>(&storage);
+ *     eq.coeff_lowShelf(0, eq.calc_omega_from_Hz(80), 0.707, 3);
+ *     eq.coeff_peakEQ(1, eq.calc_omega_from_Hz(1200), 1, -4);
+ *     eq.design(2, [w](auto &bq) { bq.coeff_HP(w, 0.707); });
+ *     eq.setBypass(3, true);
+ *     ...
+ *     eq.process_block(L, R);
+ * ```
+ */
+template <typename TuningAndDBProvider, size_t BLOCK_SIZE, size_t N,
+          typename Adapter = DefaultTuningAndDBAdapter<TuningAndDBProvider>>
+struct alignas(16) EQChain
+{
+    static_assert(N > 0, "An EQChain needs at least one band");
+
+    using designer_t = BiquadFilter<TuningAndDBProvider, BLOCK_SIZE, Adapter>;
+
+    EQChain(TuningAndDBProvider *s = nullptr) : designer(s)
+    {
+        std::fill(bypassed, bypassed + N, false);
+        suspend();
+    }
+
+    /**
+     * Set a band from any of BiquadFilter's coeff_ methods, for instance
+     * `eq.design(band, [w](auto &bq) { bq.coeff_HP(w, 0.707); });`. As with a BiquadFilter the
+     * first design of a band starts there and later ones are smoothed towards.
+     */
+    template <typename F> void design(size_t band, F &&f)
+    {
+        assert(band < N);
+        f(designer);
+        auto c = designer.targetCoefficients();
+        const double v[nCoeffs] = {c.a1, c.a2, c.b0, c.b1, c.b2};
+        for (int i = 0; i < nCoeffs; ++i)
+        {
+            target[i][band] = v[i];
+            if (firstRun[band])
+                current[i][band] = v[i];
+        }
+        if (firstRun[band])
+        {
+            firstRun[band] = false;
+            updateActiveBands();
+        }
+    }
+
+    void coeff_peakEQ(size_t band, double omega, double BW, double gain)
+    {
+        design(band, [=](auto &bq) { bq.coeff_peakEQ(omega, BW, gain); });
+    }
+    void coeff_orfanidisEQ(size_t band, double omega, double BW, double G, double GB, double G0)
+    {
+        design(band, [=](auto &bq) { bq.coeff_orfanidisEQ(omega, BW, G, GB, G0); });
+    }
+    void coeff_lowShelf(size_t band, double omega, double Q, double gain)
+    {
+        design(band, [=](auto &bq) { bq.coeff_lowShelf(omega, Q, gain); });
+    }
+    void coeff_highShelf(size_t band, double omega, double Q, double gain)
+    {
+        design(band, [=](auto &bq) { bq.coeff_highShelf(omega, Q, gain); });
+    }
+
+    void coeff_instantize()
+    {
+        for (int i = 0; i < nCoeffs; ++i)
+            std::copy(target[i], target[i] + NP, current[i]);
+    }
+
+    double calc_omega(double scfreq) { return designer.calc_omega(scfreq); }
+    double calc_omega_from_Hz(double Hz) { return designer.calc_omega_from_Hz(Hz); }
+
+    /**
+     * A bypassed band is left out of the cascade. It restarts from silence when it comes
+     * back, so toggle bypass where that will not click.
+     */
+    void setBypass(size_t band, bool b)
+    {
+        assert(band < N);
+        if (bypassed[band] && !b)
+        {
+            std::fill(reg0[band], reg0[band] + 2, 0.0);
+            std::fill(reg1[band], reg1[band] + 2, 0.0);
+        }
+        bypassed[band] = b;
+        updateActiveBands();
+    }
+    bool isBypassed(size_t band) const { return bypassed[band]; }
+
+    void suspend()
+    {
+        for (size_t b = 0; b < N; ++b)
+        {
+            std::fill(reg0[b], reg0[b] + 2, 0.0);
+            std::fill(reg1[b], reg1[b] + 2, 0.0);
+            firstRun[b] = true;
+        }
+        for (int i = 0; i < nCoeffs; ++i)
+        {
+            std::fill(current[i], current[i] + NP, 0.0);
+            std::fill(target[i], target[i] + NP, 0.0);
+        }
+        updateActiveBands();
+    }
+
+    void process_block(float *dataL, float *dataR)
+    {
+        process_block_to(dataL, dataR, dataL, dataR);
+    }
+
+    void process_block_to(const float *const dataL, const float *const dataR, float *dstL,
+                          float *dstR)
+    {
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+        {
+            processLags();
+
+            auto x = SIMD_MM(set_pd)(dataR[k], dataL[k]);
+            for (size_t i = 0; i < nActive; ++i)
+            {
+                const auto b = activeBands[i];
+                auto r0 = SIMD_MM(load_pd)(reg0[b]);
+                auto r1 = SIMD_MM(load_pd)(reg1[b]);
+                auto ca1 = SIMD_MM(set1_pd)(current[A1][b]);
+                auto ca2 = SIMD_MM(set1_pd)(current[A2][b]);
+                auto cb0 = SIMD_MM(set1_pd)(current[B0][b]);
+                auto cb1 = SIMD_MM(set1_pd)(current[B1][b]);
+                auto cb2 = SIMD_MM(set1_pd)(current[B2][b]);
+
+                auto op = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(x, cb0), r0);
+                r0 = SIMD_MM(add_pd)(
+                    SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, cb1), SIMD_MM(mul_pd)(ca1, op)), r1);
+                r1 = SIMD_MM(sub_pd)(SIMD_MM(mul_pd)(x, cb2), SIMD_MM(mul_pd)(ca2, op));
+
+                SIMD_MM(store_pd)(reg0[b], r0);
+                SIMD_MM(store_pd)(reg1[b], r1);
+                x = op;
+            }
+
+            double out alignas(16)[2];
+            SIMD_MM(store_pd)(out, x);
+            dstL[k] = out[0];
+            dstR[k] = out[1];
+        }
+
+        for (size_t i = 0; i < nActive; ++i)
+        {
+            const auto b = activeBands[i];
+            for (int c = 0; c < 2; ++c)
+            {
+                flush_denormal(reg0[b][c]);
+                flush_denormal(reg1[b][c]);
+            }
+        }
+    }
+
+    /** The mono path runs on the left registers */
+    void process_block(float *data)
+    {
+        for (size_t k = 0; k < BLOCK_SIZE; k++)
+        {
+            processLags();
+
+            double x = data[k];
+            for (size_t i = 0; i < nActive; ++i)
+            {
+                const auto b = activeBands[i];
+                double op = x * current[B0][b] + reg0[b][0];
+                reg0[b][0] = x * current[B1][b] - current[A1][b] * op + reg1[b][0];
+                reg1[b][0] = x * current[B2][b] - current[A2][b] * op;
+                x = op;
+            }
+            data[k] = (float)x;
+        }
+
+        for (size_t i = 0; i < nActive; ++i)
+        {
+            flush_denormal(reg0[activeBands[i]][0]);
+            flush_denormal(reg1[activeBands[i]][0]);
+        }
+    }
+
+    /** The magnitude response of the active bands, with f normalised to the sample rate */
+    float plot_magnitude(float f)
+    {
+        std::complex<double> i(0, 1);
+        std::complex<double> z = exp(-2 * 3.1415 * f * i);
+
+        double r{1.0};
+        for (size_t a = 0; a < nActive; ++a)
+        {
+            const auto b = activeBands[a];
+            std::complex<double> num = current[B0][b] + current[B1][b] * z + current[B2][b] * z * z;
+            std::complex<double> den = 1.0 + current[A1][b] * z + current[A2][b] * z * z;
+            r *= abs(num / den);
+        }
+        return r;
+    }
+
+    /**
+     * The magnitude in dB of the active bands at n frequencies. Each frequency's sine is
+     * shared across all the bands.
+     */
+    void plot_magnitude_batch(const float *freqs, float *dbOut, int n)
+    {
+        details::BiquadCoefficients sections[N];
+        for (size_t a = 0; a < nActive; ++a)
+        {
+            const auto b = activeBands[a];
+            sections[a] = {current[A1][b], current[A2][b], current[B0][b], current[B1][b],
+                           current[B2][b]};
+        }
+        details::plotMagnitudeBatch(sections, nActive, freqs, dbOut, n);
+    }
+
+  protected:
+    // the BiquadFilter lag rate, so a chain smooths exactly as its bands would
+    static constexpr double lagRate{0.004};
+
+    static constexpr int nCoeffs{5};
+    enum Coeff
+    {
+        A1,
+        A2,
+        B0,
+        B1,
+        B2
+    };
+
+    // the band count rounded up to whole packed pairs
+    static constexpr size_t NP{(N + 1) & ~size_t(1)};
+
+    double current alignas(16)[nCoeffs][NP], target alignas(16)[nCoeffs][NP];
+    double reg0 alignas(16)[N][2], reg1 alignas(16)[N][2];
+
+    bool firstRun[N], bypassed[N];
+    size_t activeBands[N], nActive{0};
+
+    designer_t designer;
+
+    inline void processLags()
+    {
+        const auto lp = SIMD_MM(set1_pd)(lagRate), lpinv = SIMD_MM(set1_pd)(1.0 - lagRate);
+        for (int c = 0; c < nCoeffs; ++c)
+        {
+            for (size_t b = 0; b < NP; b += 2)
+            {
+                auto v = SIMD_MM(load_pd)(&current[c][b]);
+                auto t = SIMD_MM(load_pd)(&target[c][b]);
+                v = SIMD_MM(add_pd)(SIMD_MM(mul_pd)(v, lpinv), SIMD_MM(mul_pd)(t, lp));
+                SIMD_MM(store_pd)(&current[c][b], v);
+            }
+        }
+    }
+
+    // the bands which are designed and not bypassed
+    void updateActiveBands()
+    {
+        nActive = 0;
+        for (size_t b = 0; b < N; ++b)
+            if (!bypassed[b] && !firstRun[b])
+                activeBands[nActive++] = b;
+    }
+
+    static inline void flush_denormal(double &d)
+    {
+        if (fabs(d) < 1E-30)
+        {
+            d = 0;
+        }
+    }
+};
+} // namespace sst::filters::Biquad
+
+#endif // SST_FILTERS_EQCHAIN_H
@@ -409,6 +409,18 @@ enum FilterSubType
     st_obxdxpander_ph3lp1 = 14
 };
 
+/**
+ * How accurately the saturating models evaluate their nonlinearities. Standard is what
+ * these models have always used; Cheap trades accuracy for speed on large voice counts
+ * and Accurate is intended for offline rendering. See Nonlinearity.h.
+ */
+enum struct NonlinearityAccuracy
+{
+    Cheap,
+    Standard,
+    Accurate
+};
+
 } // namespace sst::filters
 
 #endif // SST_FILTERS_FILTERCONFIGURATION_H
@@ -0,0 +1,174 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_FILTERUNITTRAITS_H
+#define INCLUDE_SST_FILTERS_FILTERUNITTRAITS_H
+
+#include <cstdint>
+
+#include "QuadFilterUnit.h"
+#include "FilterConfiguration.h"
+#include "VintageLadders.h"
+
+namespace sst::filters
+{
+
+/**
+ * A rough relative CPU cost for a filter unit, for voice allocators which budget CPU.
+ * Each class is very roughly two to four times the one before.
+ */
+enum struct FilterUnitCost : uint8_t
+{
+    Light,    // a biquad or SVF worth of arithmetic
+    Moderate, // a few stages, or one cheap saturator
+    Heavy,    // several saturating stages or an iterative solver
+    VeryHeavy // internal oversampling or Runge-Kutta style integration
+};
+
+/**
+ * What a filter unit actually uses of its QuadFilterUnitState, so callers can reset, copy
+ * or migrate only the live state.
+ */
+struct FilterUnitTraits
+{
+    /** The unit only reads and writes R[0] to R[registers - 1] */
+    uint8_t registers{n_filter_registers};
+
+    /** and its output only depends on C[0] to C[coefficients - 1] */
+    uint8_t coefficients{n_cm_coeffs};
+
+    /** The floats of delay line each voice needs in DB, or 0 for none */
+    uint32_t delayLineSize{0};
+
+    /** The unit saturates, clips or otherwise depends on level */
+    bool nonlinear{false};
+
+    /** The unit's nonlinearities honour NonlinearityAccuracy */
+    bool accuracyTiers{false};
+
+    FilterUnitCost cost{FilterUnitCost::Moderate};
+};
+
+/**
+ * The traits for a filter type and sub-type. Unknown types get the conservative default
+ * of the whole state.
+ */
+constexpr FilterUnitTraits GetFilterUnitTraits(FilterType type, FilterSubType subtype)
+{
+    // the number of stages in the warp filters, from 1 to 4
+    auto warpStages = [](int st) { return (uint8_t)(st % 4 + 1); };
+
+    switch (type)
+    {
+    case fut_lp12:
+    case fut_hp12:
+    case fut_bp12:
+        // Standard is the SVF; Driven and Clean are the IIR forms with a clip gain in C[7]
+        return {3, (uint8_t)(subtype == st_Standard ? 4 : 8), 0, true, false,
+                FilterUnitCost::Light};
+    case fut_lp24:
+    case fut_hp24:
+    case fut_bp24:
+        return {5, (uint8_t)(subtype == st_Standard ? 4 : 8), 0, true, false,
+                FilterUnitCost::Light};
+    case fut_notch12:
+    case fut_apf:
+        return {3, 8, 0, true, false, FilterUnitCost::Light};
+    case fut_notch24:
+        return {5, 8, 0, true, false, FilterUnitCost::Light};
+    case fut_lpmoog:
+        return {5, 3, 0, true, false, FilterUnitCost::Moderate};
+    case fut_SNH:
+        return {2, 2, 0, true, false, FilterUnitCost::Light};
+    case fut_comb_pos:
+    case fut_comb_neg:
+    {
+        uint32_t length = (subtype & static_cast<int>(QFUSubtypeMasks::EXTENDED_COMB))
+                              ? utilities::MAX_FB_COMB_EXTENDED
+                              : utilities::MAX_FB_COMB;
+        return {0, 4, length + utilities::SincTable::FIRipol_N, true, false,
+                FilterUnitCost::Moderate};
+    }
+    case fut_vintageladder:
+        switch (subtype)
+        {
+        // the ladder states, then any decimator history the default tap count keeps
+        case st_vintage_type1:
+        case st_vintage_type1_compensated:
+            return {(uint8_t)(VintageLadder::RK::decimatorHistory +
+                              VintageLadder::RK::default_decimator_t::historySize),
+                    3, 0, true, false, FilterUnitCost::VeryHeavy};
+        case st_vintage_type2:
+        case st_vintage_type2_compensated:
+            return {(uint8_t)(VintageLadder::Huov::h_decimator +
+                              VintageLadder::Huov::default_decimator_t::historySize),
+                    4, 0, true, true, FilterUnitCost::VeryHeavy};
+        case st_vintage_type3:
+        case st_vintage_type3_compensated:
+            return {10, 4, 0, true, true, FilterUnitCost::Heavy};
+        default:
+            break;
+        }
+        break;
+    case fut_obxd_2pole_lp:
+    case fut_obxd_2pole_hp:
+    case fut_obxd_2pole_bp:
+    case fut_obxd_2pole_n:
+        return {2, 5, 0, true, false, FilterUnitCost::Moderate};
+    case fut_obxd_4pole:
+        return {4, (uint8_t)(subtype == st_obxd4pole_morph ? 8 : 4), 0, true, false,
+                FilterUnitCost::Heavy};
+    case fut_obxd_xpander:
+        return {4, 4, 0, true, false, FilterUnitCost::Heavy};
+    case fut_k35_lp:
+    case fut_k35_hp:
+        return {3, 8, 0, true, true, FilterUnitCost::Moderate};
+    case fut_diode:
+        return {7, 8, 0, false, false, FilterUnitCost::Moderate};
+    case fut_cutoffwarp_lp:
+    case fut_cutoffwarp_hp:
+    case fut_cutoffwarp_n:
+    case fut_cutoffwarp_bp:
+    case fut_cutoffwarp_ap:
+    {
+        auto stages = warpStages(subtype - st_cutoffwarp_tanh1);
+        return {(uint8_t)(2 * stages), 6, 0, true, subtype <= st_cutoffwarp_tanh4,
+                stages > 2 ? FilterUnitCost::Heavy : FilterUnitCost::Moderate};
+    }
+    case fut_resonancewarp_lp:
+    case fut_resonancewarp_hp:
+    case fut_resonancewarp_n:
+    case fut_resonancewarp_bp:
+    case fut_resonancewarp_ap:
+    {
+        auto stages = warpStages(subtype - st_resonancewarp_tanh1);
+        return {(uint8_t)(2 * stages), 5, 0, true, subtype <= st_resonancewarp_tanh4,
+                stages > 2 ? FilterUnitCost::Heavy : FilterUnitCost::Moderate};
+    }
+    case fut_tripole:
+        return {8, 7, 0, true, true, FilterUnitCost::VeryHeavy};
+    case fut_cytomic_svf:
+        // the low pass skips the high and band pass mix coefficients
+        return {2, (uint8_t)(subtype == st_cytomic_lp ? 3 : 6), 0, false, false,
+                FilterUnitCost::Light};
+    case fut_none:
+    case num_filter_types:
+        break;
+    }
+
+    return {};
+}
+} // namespace sst::filters
+
+#endif // SST_FILTERS_FILTERUNITTRAITS_H
@@ -0,0 +1,171 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_HALFRATEDESIGNER_H
+#define INCLUDE_SST_FILTERS_HALFRATEDESIGNER_H
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include "HalfRateFilter.h"
+
+/**
+ * Runtime design of the polyphase allpass half band filters used by HalfRateFilter and
+ * QuadHalfRateFilter.
+ *
+ * The half band is the sum of two branches of allpasses in z^-2. Its coefficients follow from
+ * an elliptic prototype with the given transition band, using the Valenzuela / Constantinides
+ * method as popularised by Laurent de Soras' HIIR. The tables in
+ * HalfRateFilter::load_coefficients are points of this design, so for instance
+ * designForOrder(6, 0.01f) reproduces the M = 6 steep filter.
+ *
+ * The transition band is normalised to the higher of the two sample rates, between 0 and 0.5,
+ * as in the load_coefficients comments. Designs are cached, so repeated requests for the same
+ * filter are cheap and return the same object; still, prefer to design outside the audio
+ * thread.
+ *
+ * ```cpp
+ *     // the cheapest filter with 90dB of rejection and a 0.02 transition band
+ *     const auto &d = HalfRateDesigner::designForSpec(90.f, 0.02f);
+ *     auto hr = HalfRateFilter(d.M, d.cA, d.cB);
+ * ```
+ */
+namespace sst::filters::HalfRate::HalfRateDesigner
+{
+struct Design
+{
+    // allpass sections per branch
+    uint32_t M{0};
+    float transition{0.f};
+    // stopband rejection in dB
+    float attenuation{0.f};
+    float cA[halfrate_max_M]{}, cB[halfrate_max_M]{};
+};
+
+namespace details
+{
+// The elliptic modulus k and nome q for a transition band
+inline std::pair<double, double> transitionParameters(double transition)
+{
+    auto k = std::tan((1.0 - transition * 2.0) * M_PI / 4.0);
+    k *= k;
+    const auto kksqrt = std::pow(1.0 - k * k, 0.25);
+    const auto e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const auto e4 = e * e * e * e;
+    const auto q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    return {k, q};
+}
+
+// order is the order of the prototype, 2 * (2 * M) + 1
+inline double attenuation(double q, int order)
+{
+    const auto a = 4.0 * std::exp(order * 0.5 * std::log(q));
+    return -10.0 * std::log10(a / (1.0 + a));
+}
+
+inline double coefficient(int index, double k, double q, int order)
+{
+    // theta function series for the numerator and denominator of the pole position
+    const auto c = index + 1;
+    double num{0}, den{0.5};
+    for (int i = 0, sign = 1; i < 64; ++i, sign = -sign)
+    {
+        const auto qp = std::pow(q, i * (i + 1));
+        num += sign * qp * std::sin((i * 2 + 1) * c * M_PI / order);
+        if (qp < 1e-100)
+            break;
+    }
+    for (int i = 1, sign = -1; i < 64; ++i, sign = -sign)
+    {
+        const auto qp = std::pow(q, i * i);
+        den += sign * qp * std::cos(i * 2 * c * M_PI / order);
+        if (qp < 1e-100)
+            break;
+    }
+
+    const auto ww = num * std::pow(q, 0.25) / den;
+    const auto wwsq = ww * ww;
+    const auto x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+    return (1.0 - x) / (1.0 + x);
+}
+} // namespace details
+
+/**
+ * The stopband rejection in dB of a filter with M sections per branch and the given
+ * transition band, without designing it.
+ */
+inline float attenuationFor(uint32_t M, float transition)
+{
+    assert(transition > 0.f && transition < 0.5f);
+    auto [k, q] = details::transitionParameters(transition);
+    return (float)details::attenuation(q, 4 * M + 1);
+}
+
+/**
+ * Design a filter with M sections per branch (1 to halfrate_max_M) and the given transition
+ * band.
+ */
+inline const Design &designForOrder(uint32_t M, float transition)
+{
+    assert(M >= 1 && M <= halfrate_max_M);
+    assert(transition > 0.f && transition < 0.5f);
+
+    static std::mutex cacheMutex;
+    static std::map<std::pair<uint32_t, float>, Design> cache;
+
+    std::lock_guard<std::mutex> g(cacheMutex);
+    auto key = std::make_pair(M, transition);
+    auto pos = cache.find(key);
+    if (pos != cache.end())
+        return pos->second;
+
+    auto [k, q] = details::transitionParameters(transition);
+    const int order = 4 * M + 1;
+
+    Design d;
+    d.M = M;
+    d.transition = transition;
+    d.attenuation = (float)details::attenuation(q, order);
+    // The coefficients come out in increasing order and alternate between the branches
+    for (auto i = 0U; i < 2 * M; ++i)
+    {
+        auto c = (float)details::coefficient(i, k, q, order);
+        if (i & 1)
+            d.cB[i >> 1] = c;
+        else
+            d.cA[i >> 1] = c;
+    }
+
+    return cache.emplace(key, d).first->second;
+}
+
+/**
+ * Design the cheapest filter with at least `attenuation` dB of stopband rejection for the
+ * given transition band. If even halfrate_max_M sections fall short, that is the design
+ * returned, so compare its attenuation with the request if that matters.
+ */
+inline const Design &designForSpec(float attenuation, float transition)
+{
+    uint32_t M{1};
+    while (M < halfrate_max_M && attenuationFor(M, transition) < attenuation)
+        M++;
+    return designForOrder(M, transition);
+}
+} // namespace sst::filters::HalfRate::HalfRateDesigner
+
+#endif // SST_FILTERS_HALFRATEDESIGNER_H
@@ -57,6 +57,23 @@ class alignas(16) HalfRateFilter
         reset();
     }
 
+    /**
+     * Implement a half rate up/down filter with explicit coefficients, for instance from
+     * HalfRateDesigner
+     *
+     * @param M The number of allpass sections per branch. Range from 1 to halfrate_max_M
+     * @param cA the M coefficients of the A branch
+     * @param cB the M coefficients of the B branch
+     */
+    HalfRateFilter(uint32_t M, const float *cA, const float *cB)
+    {
+        assert(!(M > halfrate_max_M));
+        this->M = M;
+        this->steep = false;
+        set_coefficients(cA, cB);
+        reset();
+    }
+
     void process_block(float *floatL, float *floatR, int nsamples)
     {
         SIMD_M128 *__restrict L = (SIMD_M128 *)floatL;
@@ -632,12 +649,36 @@ class alignas(16) HalfRateFilter
             vy2[j] = ty2;
         }
 
+        // Same reconstruction as process_block_D2: the A branch of the second sample plus the
+        // B branch of the first, so L = (oS[1][0] + oS[0][1]) / 2 and R = (oS[1][2] + oS[0][3]) / 2
+        auto sum = SIMD_MM(add_ps)(oS[1],
+                                   SIMD_MM(shuffle_ps)(oS[0], oS[0], SIMD_MM_SHUFFLE(3, 3, 1, 1)));
+        sum = SIMD_MM(mul_ps)(sum, half);
+
         float res alignas(16)[4];
-        SIMD_MM(store_ps)(res, oS[1]);
+        SIMD_MM(store_ps)(res, sum);
         outL = res[0];
         outR = res[2];
     }
 
+    /**
+     * The low frequency delay, in samples at the lower rate, of an upsample followed by a
+     * downsample through two filters with these settings. Each branch is a chain of allpasses
+     * (a + z^-2) / (1 + a z^-2) which delay DC by 2 (1 - a) / (1 + a) samples at the higher
+     * rate, and the two branches agree at DC so the pair delays by their average.
+     */
+    float latency() const
+    {
+        float res{0.f};
+        for (auto i = 0U; i < M; i++)
+        {
+            float c alignas(16)[4];
+            SIMD_MM(store_ps)(c, va[i]);
+            res += (1.f - c[0]) / (1.f + c[0]) + (1.f - c[1]) / (1.f + c[1]);
+        }
+        return res;
+    }
+
     void load_coefficients()
     {
         for (auto i = 0U; i < M; i++)
@@ -645,6 +686,25 @@ class alignas(16) HalfRateFilter
             va[i] = SIMD_MM(setzero_ps)();
         }
 
+        float cA[halfrate_max_M], cB[halfrate_max_M];
+        get_coefficients(M, steep, cA, cB);
+        set_coefficients(cA, cB);
+    }
+
+    /**
+     * The allpass coefficients of the A and B branches for a filter of size M. These are
+     * shared with QuadHalfRateFilter, which lays them out differently.
+     */
+    static void get_coefficients(uint32_t M, bool steep, float *cA, float *cB)
+    {
+        auto copy_coefficients = [M, cA, cB](const float *a, const float *b) {
+            for (auto i = 0U; i < M; i++)
+            {
+                cA[i] = a[i];
+                cB[i] = b[i];
+            }
+        };
+
         int order = M << 1;
         if (steep)
         {
@@ -658,7 +718,7 @@ class alignas(16) HalfRateFilter
                                            0.6775400499741616f,  0.839889624849638f,
                                            0.9315419599631839f,  0.9878163707328971f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 10) // rejection=86dB, transition band=0.01
             {
@@ -670,7 +730,7 @@ class alignas(16) HalfRateFilter
                                            0.7810257527489514f, 0.9141815687605308f,
                                            0.985475023014907f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 8) // rejection=69dB, transition band=0.01
             {
@@ -680,7 +740,7 @@ class alignas(16) HalfRateFilter
                 float b_coefficients[4] = {0.2659685265210946f, 0.6651041532634957f,
                                            0.8841015085506159f, 0.9820054141886075f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 6) // rejection=51dB, transition band=0.01
             {
@@ -690,7 +750,7 @@ class alignas(16) HalfRateFilter
                 float b_coefficients[3] = {0.40056789819445626f, 0.8204163891923343f,
                                            0.9763114515836773f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 4) // rejection=53dB,transition band=0.05
             {
@@ -698,7 +758,7 @@ class alignas(16) HalfRateFilter
 
                 float b_coefficients[2] = {0.3903621872345006f, 0.890786832653497f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
 
             else // order=2, rejection=36dB, transition band=0.1
@@ -706,7 +766,7 @@ class alignas(16) HalfRateFilter
                 float a_coefficients = 0.23647102099689224f;
                 float b_coefficients = 0.7145421497126001f;
 
-                set_coefficients(&a_coefficients, &b_coefficients);
+                copy_coefficients(&a_coefficients, &b_coefficients);
             }
         }
         else // softer slopes, more attenuation and less stopband ripple
@@ -721,7 +781,7 @@ class alignas(16) HalfRateFilter
                                            0.4364942348420355f,  0.6329609551399348f,
                                            0.80378086794111226f, 0.9599687404800694f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 10) // rejection=133dB, transition band=0.05
             {
@@ -733,7 +793,7 @@ class alignas(16) HalfRateFilter
                                            0.5516782402507934f, 0.7652146863779808f,
                                            0.95247728378667541f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 8) // rejection=106dB, transition band=0.05
             {
@@ -743,7 +803,7 @@ class alignas(16) HalfRateFilter
                 float b_coefficients[4] = {0.1340901419430669f, 0.4243248712718685f,
                                            0.7062921421386394f, 0.9415030941737551f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 6) // rejection=80dB, transition band=0.05
             {
@@ -753,7 +813,7 @@ class alignas(16) HalfRateFilter
                 float b_coefficients[3] = {0.21597144456092948f, 0.6043586264658363f,
                                            0.9238861386532906f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
             else if (order == 4) // rejection=70dB,transition band=0.1
             {
@@ -761,7 +821,7 @@ class alignas(16) HalfRateFilter
 
                 float b_coefficients[2] = {0.28382934487410993f, 0.8344118914807379f};
 
-                set_coefficients(a_coefficients, b_coefficients);
+                copy_coefficients(a_coefficients, b_coefficients);
             }
 
             else // order=2, rejection=36dB, transition band=0.1
@@ -769,11 +829,11 @@ class alignas(16) HalfRateFilter
                 float a_coefficients = 0.23647102099689224f;
                 float b_coefficients = 0.7145421497126001f;
 
-                set_coefficients(&a_coefficients, &b_coefficients);
+                copy_coefficients(&a_coefficients, &b_coefficients);
             }
         }
     }
-    void set_coefficients(float *cA, float *cB)
+    void set_coefficients(const float *cA, const float *cB)
     {
         for (auto i = 0U; i < M; i++)
         {
@@ -801,6 +861,192 @@ class alignas(16) HalfRateFilter
     // unsigned int BLOCK_SIZE;
 };
 
+/**
+ * A half rate up/down filter for four independent channels, one per SIMD lane, matching the
+ * voice layout of QuadFilterUnitState.
+ *
+ * HalfRateFilter spends its lanes on the A and B allpass branches of a stereo pair. Here each
+ * lane is a channel and the branches are kept as separate state. Because the branches of the
+ * half band filter only ever see the even or the odd samples at the higher rate, they run at
+ * the lower rate, which halves the work per channel relative to the stereo form. The results
+ * match HalfRateFilter channel for channel.
+ *
+ * Samples are SIMD_M128 holding one value per channel. Upsampling is full scale.
+ */
+class alignas(16) QuadHalfRateFilter
+{
+  private:
+    // Remember leave these first so they stay aligned
+    SIMD_M128 vaA[halfrate_max_M], vaB[halfrate_max_M];
+    SIMD_M128 vxA[halfrate_max_M], vyA[halfrate_max_M];
+    SIMD_M128 vxB[halfrate_max_M], vyB[halfrate_max_M];
+
+    /*
+     * One sample through a branch. Each section is the allpass y = x1 + (x - y1) * a at the
+     * lower rate, which is the z^-2 form HalfRateFilter runs at the higher rate.
+     */
+    static inline SIMD_M128 allpass_chain(SIMD_M128 x, const SIMD_M128 *a, SIMD_M128 *vx,
+                                          SIMD_M128 *vy, uint32_t M)
+    {
+        for (auto j = 0U; j < M; j++)
+        {
+            auto y = SIMD_MM(add_ps)(vx[j], SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(x, vy[j]), a[j]));
+            vx[j] = x;
+            vy[j] = y;
+            x = y;
+        }
+        return x;
+    }
+
+    /*
+     * The same over a buffer in place, section by section so the state stays in registers.
+     * Each x[k * stride] is one sample of the branch.
+     */
+    static inline void allpass_chain_block(SIMD_M128 *x, int n, int stride, const SIMD_M128 *a,
+                                           SIMD_M128 *vx, SIMD_M128 *vy, uint32_t M)
+    {
+        for (auto j = 0U; j < M; j++)
+        {
+            auto tx = vx[j];
+            auto ty = vy[j];
+            auto ta = a[j];
+            for (int k = 0; k < n; k++)
+            {
+                auto xk = x[k * stride];
+                ty = SIMD_MM(add_ps)(tx, SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(xk, ty), ta));
+                tx = xk;
+                x[k * stride] = ty;
+            }
+            vx[j] = tx;
+            vy[j] = ty;
+        }
+    }
+
+  public:
+    /**
+     * @param M The size of the FIR. Range from 1 to halfrate_max_M
+     * @param steep Steepness, as for HalfRateFilter
+     */
+    QuadHalfRateFilter(uint32_t M, bool steep)
+    {
+        assert(!(M > halfrate_max_M));
+        this->M = M;
+        this->steep = steep;
+
+        float cA[halfrate_max_M], cB[halfrate_max_M];
+        HalfRateFilter::get_coefficients(M, steep, cA, cB);
+        set_coefficients(cA, cB);
+        reset();
+    }
+
+    /**
+     * @param M The number of allpass sections per branch. Range from 1 to halfrate_max_M
+     * @param cA the M coefficients of the A branch
+     * @param cB the M coefficients of the B branch
+     */
+    QuadHalfRateFilter(uint32_t M, const float *cA, const float *cB)
+    {
+        assert(!(M > halfrate_max_M));
+        this->M = M;
+        this->steep = false;
+        set_coefficients(cA, cB);
+        reset();
+    }
+
+    void set_coefficients(const float *cA, const float *cB)
+    {
+        for (auto i = 0U; i < M; i++)
+        {
+            vaA[i] = SIMD_MM(set1_ps)(cA[i]);
+            vaB[i] = SIMD_MM(set1_ps)(cB[i]);
+        }
+    }
+
+    /**
+     * Upsample one sample per channel into two
+     */
+    void process_sample_U2(SIMD_M128 in, SIMD_M128 out[2])
+    {
+        out[0] = allpass_chain(in, vaA, vxA, vyA, M);
+        out[1] = allpass_chain(in, vaB, vxB, vyB, M);
+    }
+
+    /**
+     * Downsample two samples per channel into one
+     */
+    SIMD_M128 process_sample_D2(const SIMD_M128 in[2])
+    {
+        auto b = allpass_chain(in[0], vaB, vxB, vyB, M);
+        auto a = allpass_chain(in[1], vaA, vxA, vyA, M);
+        return SIMD_MM(mul_ps)(SIMD_MM(add_ps)(a, b), SIMD_MM(set1_ps)(0.5f));
+    }
+
+    /**
+     * Upsample nsamples / 2 samples from in into nsamples samples in out. in and out may not
+     * overlap.
+     */
+    void process_block_U2(const SIMD_M128 *in, SIMD_M128 *out, int nsamples)
+    {
+        for (int k = 0; k < nsamples; k += 2)
+        {
+            out[k] = in[k >> 1];
+            out[k + 1] = in[k >> 1];
+        }
+        allpass_chain_block(out, nsamples >> 1, 2, vaA, vxA, vyA, M);
+        allpass_chain_block(out + 1, nsamples >> 1, 2, vaB, vxB, vyB, M);
+    }
+
+    /**
+     * Downsample nsamples samples from in into nsamples / 2 samples in out. out may be in.
+     */
+    void process_block_D2(const SIMD_M128 *in, SIMD_M128 *out, int nsamples)
+    {
+        SIMD_M128 o[hr_BLOCK_SIZE];
+        for (int k = 0; k < nsamples; k++)
+        {
+            o[k] = in[k];
+        }
+        allpass_chain_block(o, nsamples >> 1, 2, vaB, vxB, vyB, M);
+        allpass_chain_block(o + 1, nsamples >> 1, 2, vaA, vxA, vyA, M);
+
+        const auto half = SIMD_MM(set1_ps)(0.5f);
+        for (int k = 0; k < nsamples; k += 2)
+        {
+            out[k >> 1] = SIMD_MM(mul_ps)(SIMD_MM(add_ps)(o[k], o[k + 1]), half);
+        }
+    }
+
+    /**
+     * As HalfRateFilter::latency
+     */
+    float latency() const
+    {
+        float res{0.f};
+        for (auto i = 0U; i < M; i++)
+        {
+            auto a = SIMD_MM(cvtss_f32)(vaA[i]);
+            auto b = SIMD_MM(cvtss_f32)(vaB[i]);
+            res += (1.f - a) / (1.f + a) + (1.f - b) / (1.f + b);
+        }
+        return res;
+    }
+
+    void reset()
+    {
+        for (auto i = 0U; i < M; i++)
+        {
+            vxA[i] = SIMD_MM(setzero_ps)();
+            vyA[i] = SIMD_MM(setzero_ps)();
+            vxB[i] = SIMD_MM(setzero_ps)();
+            vyB[i] = SIMD_MM(setzero_ps)();
+        }
+    }
+
+  private:
+    uint32_t M;
+    bool steep;
+};
+
 } // namespace sst::filters::HalfRate
 
 #endif // SST_FILTERS_K35FILTER_H
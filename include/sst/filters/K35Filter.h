@@ -18,6 +18,7 @@
 #include "sst/basic-blocks/dsp/FastMath.h"
 #include "QuadFilterUnit.h"
 #include "FilterCoefficientMaker.h"
+#include "Nonlinearity.h"
 
 /**
  * This namespace contains an adaptation of the filter from
@@ -126,6 +127,7 @@ inline void processCoeffs(QuadFilterUnitState *__restrict f)
         f->C[i] = A(f->C[i], f->dC[i]);
 }
 
+template <NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process_lp(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 {
     processCoeffs(f);
@@ -135,7 +137,7 @@ inline SIMD_M128 process_lp(QuadFilterUnitState *__restrict f, SIMD_M128 input)
     const auto s35 = A(M(f->C[k35_lb], f->R[k35_2z]), M(f->C[k35_hb], f->R[k35_hz]));
     // alpha * (y1 + s35)
     const auto u_clean = M(f->C[k35_alpha], A(y1, s35));
-    const auto u_driven = basic_blocks::dsp::fasttanhSSEclamped(M(u_clean, f->C[k35_saturation]));
+    const auto u_driven = Nonlinearity::tanh<accuracy>(M(u_clean, f->C[k35_saturation]));
     const auto u =
         A(M(u_clean, f->C[k35_saturation_blend_inv]), M(u_driven, f->C[k35_saturation_blend]));
 
@@ -148,6 +150,7 @@ inline SIMD_M128 process_lp(QuadFilterUnitState *__restrict f, SIMD_M128 input)
     return result;
 }
 
+template <NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process_hp(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 {
     processCoeffs(f);
@@ -160,7 +163,7 @@ inline SIMD_M128 process_hp(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 
     // mk * lpf2(u)
     const auto y_clean = M(f->C[k35_k], u);
-    const auto y_driven = basic_blocks::dsp::fasttanhSSEclamped(M(y_clean, f->C[k35_saturation]));
+    const auto y_driven = Nonlinearity::tanh<accuracy>(M(y_clean, f->C[k35_saturation]));
     const auto y =
         A(M(y_clean, f->C[k35_saturation_blend_inv]), M(y_driven, f->C[k35_saturation_blend]));
 
@@ -17,6 +17,7 @@
 #define INCLUDE_SST_FILTERS_LINKWITZRILEY_H
 
 #include <array>
+#include <cassert>
 
 #include "CytomicSVF.h"
 
@@ -172,6 +173,323 @@ struct LinkwitzRileyLR4Crossover
 #undef LR_MUL
 };
 
+/*
+ * A Linkwitz-Riley stereo crossover whose order, LR2, LR4 or LR8, is picked at runtime, for
+ * slope menus. It packs [L, R, L, R] exactly as LinkwitzRileyLR4Crossover does, over up to
+ * four preallocated CytomicSVF stages. An LR(2n) is an order n Butterworth squared, so
+ *
+ *   - LR2 is one section with k = 2 (Q = 1/2). Its bands are 180 degrees apart, so the high
+ *     band is inverted to make them sum flat.
+ *   - LR4 is two Butterworth sections, and matches LinkwitzRileyLR4Crossover sample for
+ *     sample.
+ *   - LR8 is the two sections of a 4th order Butterworth, twice.
+ *
+ * Stages with the same damping share their coefficients through fetchCoeffs.
+ */
+struct LinkwitzRileyCrossover
+{
+    static constexpr int maxStages{4};
+    CytomicSVF stages[maxStages];
+
+    // res for the k = 2 cos(pi / 8) and k = 2 cos(3 pi / 8) sections of a 4th order Butterworth
+    static constexpr float butterworth4ResA{0.07612046748871326f};
+    static constexpr float butterworth4ResB{0.6173165676349102f};
+
+    static constexpr std::array<CytomicSVF::Mode, 4> crossoverModes{
+        LinkwitzRileyLR4Crossover::crossoverModes};
+
+    void init()
+    {
+        for (auto &s : stages)
+            s.init();
+    }
+
+    /*
+     * Pick order 2, 4 or 8. This restarts the filter from silence and, once setCoeff has been
+     * called, keeps the crossover frequency.
+     */
+    void setOrder(int o)
+    {
+        assert(o == 2 || o == 4 || o == 8);
+        order = o;
+        nStages = (o == 2) ? 1 : (o == 4 ? 2 : 4);
+        init();
+        firstBlock = true;
+        if (lastSrInv > 0)
+            setCoeff(lastFreq, lastSrInv);
+    }
+    int getOrder() const { return order; }
+
+    void setCoeff(float crossoverFreq, float srInv)
+    {
+        lastFreq = crossoverFreq;
+        lastSrInv = srInv;
+
+        switch (order)
+        {
+        case 2:
+            stages[0].setCoeff(crossoverModes, crossoverFreq, 0.f, srInv);
+            break;
+        case 4:
+            stages[0].setCoeff(crossoverModes, crossoverFreq,
+                               LinkwitzRileyLR4Crossover::butterworthRes, srInv);
+            stages[1].fetchCoeffs(stages[0]);
+            break;
+        default:
+            stages[0].setCoeff(crossoverModes, crossoverFreq, butterworth4ResA, srInv);
+            stages[1].setCoeff(crossoverModes, crossoverFreq, butterworth4ResB, srInv);
+            stages[2].fetchCoeffs(stages[0]);
+            stages[3].fetchCoeffs(stages[1]);
+            break;
+        }
+    }
+
+    void step(float L, float R, float &lowL, float &lowR, float &highL, float &highR)
+    {
+        auto v = SIMD_MM(set_ps)(R, L, R, L); // [L, R, L, R]
+        for (int i = 0; i < nStages; ++i)
+            v = CytomicSVF::stepSSE(stages[i], v);
+        if (order == 2)
+            v = SIMD_MM(mul_ps)(v, lr2Polarity);
+
+        float r4 alignas(16)[4];
+        SIMD_MM(store_ps)(r4, v);
+        lowL = r4[0];
+        lowR = r4[1];
+        highL = r4[2];
+        highR = r4[3];
+    }
+
+    /*
+     * Block processing with the a1/a2/a3 coefficients of each stage smoothed across the
+     * block, as in LinkwitzRileyLR4Crossover.
+     */
+    template <int blockSize> void setCoeffForBlock(float crossoverFreq, float srInv)
+    {
+        SIMD_M128 a1p[maxStages], a2p[maxStages], a3p[maxStages];
+        for (int i = 0; i < nStages; ++i)
+        {
+            a1p[i] = stages[i].a1;
+            a2p[i] = stages[i].a2;
+            a3p[i] = stages[i].a3;
+        }
+
+        setCoeff(crossoverFreq, srInv);
+
+        static constexpr float obsf = 1.f / blockSize;
+        auto obs = SIMD_MM(set1_ps)(obsf);
+
+        for (int i = 0; i < nStages; ++i)
+        {
+            if (firstBlock)
+            {
+                a1p[i] = stages[i].a1;
+                a2p[i] = stages[i].a2;
+                a3p[i] = stages[i].a3;
+            }
+
+            da1[i] = SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(stages[i].a1, a1p[i]), obs);
+            da2[i] = SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(stages[i].a2, a2p[i]), obs);
+            da3[i] = SIMD_MM(mul_ps)(SIMD_MM(sub_ps)(stages[i].a3, a3p[i]), obs);
+
+            stages[i].a1 = a1p[i];
+            stages[i].a2 = a2p[i];
+            stages[i].a3 = a3p[i];
+        }
+        firstBlock = false;
+    }
+
+    template <int blockSize> void retainCoeffForBlock()
+    {
+        for (int i = 0; i < maxStages; ++i)
+        {
+            da1[i] = SIMD_MM(setzero_ps)();
+            da2[i] = SIMD_MM(setzero_ps)();
+            da3[i] = SIMD_MM(setzero_ps)();
+        }
+    }
+
+    void processBlockStep(float L, float R, float &lowL, float &lowR, float &highL, float &highR)
+    {
+        step(L, R, lowL, lowR, highL, highR);
+        for (int i = 0; i < nStages; ++i)
+        {
+            stages[i].a1 = SIMD_MM(add_ps)(stages[i].a1, da1[i]);
+            stages[i].a2 = SIMD_MM(add_ps)(stages[i].a2, da2[i]);
+            stages[i].a3 = SIMD_MM(add_ps)(stages[i].a3, da3[i]);
+        }
+    }
+
+    template <int blockSize>
+    void processBlock(const float *const inL, const float *const inR, float *lowL, float *lowR,
+                      float *highL, float *highR)
+    {
+        for (int i = 0; i < blockSize; ++i)
+            processBlockStep(inL[i], inR[i], lowL[i], lowR[i], highL[i], highR[i]);
+    }
+
+  private:
+    int order{4}, nStages{2};
+    float lastFreq{0.f}, lastSrInv{0.f};
+
+    const SIMD_M128 lr2Polarity{SIMD_MM(set_ps)(-1.f, -1.f, 1.f, 1.f)};
+
+    SIMD_M128 da1[maxStages]{}, da2[maxStages]{}, da3[maxStages]{};
+    bool firstBlock{true};
+};
+
+/*
+ * An NBands stereo crossover for multiband processing, built as a tree of LR4 splits.
+ *
+ * The splits run bottom up: the lowest splits the input, and each split after that splits
+ * the high band of the one before. A band below split j has missed that split's phase
+ * rotation, which for an LR4 is the second order allpass LP + HP, so each split also runs
+ * that allpass over every band below it. Then all bands share the same total phase and
+ * sum back to an allpassed copy of the input with a flat magnitude.
+ *
+ * The splits keep the LR4 [L, R, L, R] packing, and the compensation packs two stereo bands
+ * per register, so an N band tree is 2 (N - 1) SVF steps for the splits plus about
+ * (N - 1)(N - 2) / 4 for the allpasses. Each allpass shares its split's coefficients and so
+ * also shares its smoothing.
+ */
+template <int NBands> struct MultibandCrossover
+{
+    static_assert(NBands >= 2 && NBands <= 8, "MultibandCrossover supports 2 to 8 bands");
+    static constexpr int nSplits{NBands - 1};
+    static constexpr int nPairs{(NBands + 1) / 2};
+
+    LinkwitzRileyLR4Crossover splits[nSplits];
+
+    void init()
+    {
+        for (auto &x : splits)
+            x.init();
+        for (auto &ap : allpasses)
+            for (auto &a : ap)
+                a.init();
+    }
+
+    /** Set the nSplits crossover frequencies, in ascending order */
+    void setCoeff(const float *crossoverFreqs, float srInv)
+    {
+        for (int j = 0; j < nSplits; ++j)
+        {
+            splits[j].setCoeff(crossoverFreqs[j], srInv);
+            setAllpassCoeff(j, crossoverFreqs[j], srInv);
+        }
+    }
+
+    template <int blockSize> void setCoeffForBlock(const float *crossoverFreqs, float srInv)
+    {
+        for (int j = 0; j < nSplits; ++j)
+        {
+            splits[j].template setCoeffForBlock<blockSize>(crossoverFreqs[j], srInv);
+            setAllpassCoeff(j, crossoverFreqs[j], srInv);
+        }
+    }
+
+    template <int blockSize> void retainCoeffForBlock()
+    {
+        for (auto &x : splits)
+            x.template retainCoeffForBlock<blockSize>();
+    }
+
+    /** One stereo sample in, NBands stereo samples out, lowest band first */
+    void step(float L, float R, float *bandL, float *bandR)
+    {
+        stepImpl<false>(L, R, bandL, bandR);
+    }
+
+    /** The same, advancing the smoothing started by setCoeffForBlock */
+    void processBlockStep(float L, float R, float *bandL, float *bandR)
+    {
+        stepImpl<true>(L, R, bandL, bandR);
+    }
+
+    template <int blockSize>
+    void processBlock(const float *const inL, const float *const inR, float *const *bandL,
+                      float *const *bandR)
+    {
+        float l[NBands], r[NBands];
+        for (int i = 0; i < blockSize; ++i)
+        {
+            processBlockStep(inL[i], inR[i], l, r);
+            for (int b = 0; b < NBands; ++b)
+            {
+                bandL[b][i] = l[b];
+                bandR[b][i] = r[b];
+            }
+        }
+    }
+
+  private:
+    // allpasses[j][p] compensates bands 2p and 2p + 1 for split j, so only p < (j + 1) / 2 run
+    CytomicSVF allpasses[nSplits][nPairs];
+
+    void setAllpassCoeff(int j, float freq, float srInv)
+    {
+        for (int p = 0; p < (j + 1) / 2; ++p)
+            allpasses[j][p].setCoeff(CytomicSVF::Mode::Allpass, freq,
+                                     LinkwitzRileyLR4Crossover::butterworthRes, srInv);
+    }
+
+    template <bool smoothed> void stepImpl(float L, float R, float *bandL, float *bandR)
+    {
+        SIMD_M128 pairs[nPairs];
+        auto x = SIMD_MM(set_ps)(R, L, R, L); // [L, R, L, R]
+
+        for (int j = 0; j < nSplits; ++j)
+        {
+            auto &xo = splits[j];
+
+            // the bands already split off get this split's phase, with its current coefficients
+            for (int p = 0; p < (j + 1) / 2; ++p)
+            {
+                auto &ap = allpasses[j][p];
+                ap.a1 = xo.stage1.a1;
+                ap.a2 = xo.stage1.a2;
+                ap.a3 = xo.stage1.a3;
+                pairs[p] = CytomicSVF::stepSSE(ap, pairs[p]);
+            }
+
+            auto v = CytomicSVF::stepSSE(xo.stage2, CytomicSVF::stepSSE(xo.stage1, x));
+            if constexpr (smoothed)
+            {
+                xo.stage1.a1 = SIMD_MM(add_ps)(xo.stage1.a1, xo.da1);
+                xo.stage1.a2 = SIMD_MM(add_ps)(xo.stage1.a2, xo.da2);
+                xo.stage1.a3 = SIMD_MM(add_ps)(xo.stage1.a3, xo.da3);
+                xo.stage2.a1 = xo.stage1.a1;
+                xo.stage2.a2 = xo.stage1.a2;
+                xo.stage2.a3 = xo.stage1.a3;
+            }
+
+            insertBand(pairs, j, v);
+            x = SIMD_MM(shuffle_ps)(v, v, SIMD_MM_SHUFFLE(3, 2, 3, 2));
+        }
+        insertBand(pairs, nSplits, x);
+
+        float r4 alignas(16)[4];
+        for (int p = 0; p < nPairs; ++p)
+        {
+            SIMD_MM(store_ps)(r4, pairs[p]);
+            for (int h = 0; h < 2 && 2 * p + h < NBands; ++h)
+            {
+                bandL[2 * p + h] = r4[2 * h];
+                bandR[2 * p + h] = r4[2 * h + 1];
+            }
+        }
+    }
+
+    // Put the stereo band in v's low lanes into its half of its pair, zeroing an empty upper half
+    static inline void insertBand(SIMD_M128 *pairs, int b, SIMD_M128 v)
+    {
+        if (b % 2 == 0)
+            pairs[b / 2] = SIMD_MM(movelh_ps)(v, SIMD_MM(setzero_ps)());
+        else
+            pairs[b / 2] = SIMD_MM(movelh_ps)(pairs[b / 2], v);
+    }
+};
+
 } // namespace sst::filters
 
 #endif // INCLUDE_SST_FILTERS_LINKWITZRILEY_H
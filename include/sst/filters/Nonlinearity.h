@@ -0,0 +1,88 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_NONLINEARITY_H
+#define INCLUDE_SST_FILTERS_NONLINEARITY_H
+
+#include <cmath>
+#include "sst/utilities/globals.h"
+#include "sst/basic-blocks/dsp/FastMath.h"
+#include "FilterConfiguration.h"
+
+/**
+ * The nonlinear primitives used by the saturating models, at each NonlinearityAccuracy
+ * tier. The models take the tier as a template parameter defaulting to Standard, which
+ * matches what they used before the tiers existed.
+ *
+ * Only the approximated functions are tiered. Clippers which are defined by their
+ * polynomial (softclip_ps, the OJD shaper, the RK ladder clip) are already exact.
+ */
+namespace sst::filters::Nonlinearity
+{
+/**
+ * tanh(x).
+ *
+ * - Cheap: the [3/2] Pade approximant x (27 + x^2) / (27 + 9 x^2) with a reciprocal
+ *   estimate in place of the divide, clamped to +/-3 where it reaches +/-1
+ * - Standard: basic_blocks::dsp::fasttanhSSEclamped
+ * - Accurate: std::tanh on each lane
+ */
+template <NonlinearityAccuracy accuracy> inline SIMD_M128 tanh(SIMD_M128 x)
+{
+    if constexpr (accuracy == NonlinearityAccuracy::Cheap)
+    {
+        const auto three = SIMD_MM(set1_ps)(3.f), mthree = SIMD_MM(set1_ps)(-3.f);
+        const auto c27 = SIMD_MM(set1_ps)(27.f), c9 = SIMD_MM(set1_ps)(9.f);
+
+        auto xc = SIMD_MM(max_ps)(mthree, SIMD_MM(min_ps)(three, x));
+        auto x2 = SIMD_MM(mul_ps)(xc, xc);
+        auto num = SIMD_MM(mul_ps)(xc, SIMD_MM(add_ps)(c27, x2));
+        auto den = SIMD_MM(add_ps)(c27, SIMD_MM(mul_ps)(c9, x2));
+        return SIMD_MM(mul_ps)(num, SIMD_MM(rcp_ps)(den));
+    }
+    else if constexpr (accuracy == NonlinearityAccuracy::Accurate)
+    {
+        float r alignas(16)[4];
+        SIMD_MM(store_ps)(r, x);
+        for (auto &v : r)
+            v = std::tanh(v);
+        return SIMD_MM(load_ps)(r);
+    }
+    else
+    {
+        return basic_blocks::dsp::fasttanhSSEclamped(x);
+    }
+}
+
+/**
+ * 1 / sqrt(x) for x > 0.
+ *
+ * - Cheap and Standard: the hardware estimate SIMD_MM(rsqrt_ps), about 12 bits
+ * - Accurate: the estimate refined with one Newton-Raphson step, about 23 bits
+ */
+template <NonlinearityAccuracy accuracy> inline SIMD_M128 rsqrt(SIMD_M128 x)
+{
+    auto y = SIMD_MM(rsqrt_ps)(x);
+    if constexpr (accuracy == NonlinearityAccuracy::Accurate)
+    {
+        // y = y * (1.5 - 0.5 * x * y * y)
+        const auto half = SIMD_MM(set1_ps)(0.5f), threehalves = SIMD_MM(set1_ps)(1.5f);
+        auto xyy = SIMD_MM(mul_ps)(SIMD_MM(mul_ps)(x, y), y);
+        y = SIMD_MM(mul_ps)(y, SIMD_MM(sub_ps)(threehalves, SIMD_MM(mul_ps)(half, xyy)));
+    }
+    return y;
+}
+} // namespace sst::filters::Nonlinearity
+
+#endif // SST_FILTERS_NONLINEARITY_H
@@ -189,7 +189,9 @@ inline SIMD_M128 diodePairResistanceApprox(SIMD_M128 x)
     // Taylor approximation of a slightly mismatched diode pair
 }
 
-// resolve 0-delay feedback
+// resolve 0-delay feedback. Despite the name this (and NewtonRaphson24dB) is a single
+// closed form solve: the nonlinear transconductance only depends on the stored state, so
+// the feedback equation is linear in y and there are no iterations to cut short.
 inline SIMD_M128 NewtonRaphson12dB(SIMD_M128 sample, QuadFilterUnitState *__restrict f)
 {
     // calculating feedback non-linear transconducance and compensated for R (-1)
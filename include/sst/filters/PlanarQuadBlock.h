@@ -0,0 +1,103 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+
+#ifndef INCLUDE_SST_FILTERS_PLANARQUADBLOCK_H
+#define INCLUDE_SST_FILTERS_PLANARQUADBLOCK_H
+
+#include <cassert>
+
+#include "sst/basic-blocks/simd/setup.h"
+
+namespace sst::filters::details
+{
+/*
+ * Transpose four registers in place, so lane i of register j becomes lane j of register i.
+ */
+inline void transpose4x4(SIMD_M128 (&v)[4])
+{
+    auto t0 = SIMD_MM(unpacklo_ps)(v[0], v[1]);
+    auto t1 = SIMD_MM(unpacklo_ps)(v[2], v[3]);
+    auto t2 = SIMD_MM(unpackhi_ps)(v[0], v[1]);
+    auto t3 = SIMD_MM(unpackhi_ps)(v[2], v[3]);
+    v[0] = SIMD_MM(movelh_ps)(t0, t1);
+    v[1] = SIMD_MM(movehl_ps)(t1, t0);
+    v[2] = SIMD_MM(movelh_ps)(t2, t3);
+    v[3] = SIMD_MM(movehl_ps)(t3, t2);
+}
+
+/*
+ * Run a SIMD step across nChannels planar channels, with channel c on lane c % 4 of register
+ * c / 4. step(v) advances one frame of nQuads registers in place. Frames go four at a time,
+ * transposed from and back to the channel buffers, and any remainder a frame at a time. Lanes
+ * past nChannels are fed zeros and their output is dropped. in and out may be the same.
+ */
+template <int MaxQuads, typename Step>
+inline void processPlanarQuadBlock(const float *const *in, float *const *out, int nChannels,
+                                   int nQuads, int numSamples, Step &&step)
+{
+    assert(nQuads >= 0 && nQuads <= MaxQuads && nChannels <= nQuads * 4);
+
+    int n = 0;
+    for (; n + 4 <= numSamples; n += 4)
+    {
+        SIMD_M128 v[MaxQuads][4];
+        for (int q = 0; q < nQuads; ++q)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                auto ch = q * 4 + c;
+                v[q][c] = ch < nChannels ? SIMD_MM(loadu_ps)(in[ch] + n) : SIMD_MM(setzero_ps)();
+            }
+            transpose4x4(v[q]);
+        }
+
+        for (int s = 0; s < 4; ++s)
+        {
+            SIMD_M128 frame[MaxQuads];
+            for (int q = 0; q < nQuads; ++q)
+                frame[q] = v[q][s];
+            step(frame);
+            for (int q = 0; q < nQuads; ++q)
+                v[q][s] = frame[q];
+        }
+
+        for (int q = 0; q < nQuads; ++q)
+        {
+            transpose4x4(v[q]);
+            for (int c = 0; c < 4 && q * 4 + c < nChannels; ++c)
+                SIMD_MM(storeu_ps)(out[q * 4 + c] + n, v[q][c]);
+        }
+    }
+
+    for (; n < numSamples; ++n)
+    {
+        float x alignas(16)[MaxQuads * 4]{};
+        for (int c = 0; c < nChannels; ++c)
+            x[c] = in[c][n];
+
+        SIMD_M128 frame[MaxQuads];
+        for (int q = 0; q < nQuads; ++q)
+            frame[q] = SIMD_MM(load_ps)(x + 4 * q);
+        step(frame);
+        for (int q = 0; q < nQuads; ++q)
+            SIMD_MM(store_ps)(x + 4 * q, frame[q]);
+
+        for (int c = 0; c < nChannels; ++c)
+            out[c][n] = x[c];
+    }
+}
+} // namespace sst::filters::details
+
+#endif // INCLUDE_SST_FILTERS_PLANARQUADBLOCK_H
@@ -0,0 +1,141 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_POLYPHASEDECIMATOR_H
+#define INCLUDE_SST_FILTERS_POLYPHASEDECIMATOR_H
+
+#include "sst/utilities/globals.h"
+
+/**
+ * A small SIMD polyphase FIR decimator for models which run their kernel at
+ * an internal oversampled rate (see VintageLadder::RK and VintageLadder::Huov).
+ *
+ * The model hands the decimator the `factor` sub-samples it computed for the
+ * current output sample (oldest first) and a pointer to `historySize` registers
+ * of state, usually spare slots in QuadFilterUnitState::R. Each of the four lanes
+ * is filtered independently. Only one output is computed per call, which is the
+ * polyphase saving over filtering at the oversampled rate and then dropping samples.
+ *
+ * The tap count is a template parameter so callers can trade aliasing against CPU.
+ * Available designs are
+ *
+ * - factor 4: 4 taps (the legacy RK Lanczos reconstruction, no history), 8, 12 and 16 taps
+ * - factor 2: 1 tap (keep the last sub-sample, no history) and 4 taps
+ *
+ * The longer designs are Kaiser windowed (beta = 5) sincs with the cutoff at the
+ * output Nyquist. They are symmetric so they add (taps - 1) / 2 oversampled samples
+ * of latency, and are scaled to the DC gain of the short design for the same factor
+ * so switching tap counts does not change model levels.
+ *
+ * Each design also has a gain applied after the dot product. Only the legacy RK
+ * reconstruction uses one, so that it stays bit identical to the code it replaced.
+ */
+namespace sst::filters::PolyphaseDecimator
+{
+template <int factor, int taps> struct Coefficients;
+
+template <> struct Coefficients<4, 4>
+{
+    // the Lanczos factors sinc(x) sinc(x / 2) for points -1.5, -1, -0.5 and 0, with the sum
+    // scaled by 1.5 afterwards as the original code did
+    static constexpr float h[4]{-0.0636844f, 0.f, 0.57315917f, 1.f};
+    static constexpr float gain{1.5f};
+};
+
+template <> struct Coefficients<4, 8>
+{
+    static constexpr float h[8]{0.00367477f, 0.09158380f, 0.36750334f, 0.66934417f,
+                                0.66934417f, 0.36750334f, 0.09158380f, 0.00367477f};
+    static constexpr float gain{1.f};
+};
+
+template <> struct Coefficients<4, 12>
+{
+    static constexpr float h[12]{-0.00459480f, -0.01026474f, 0.02988578f, 0.16964467f,
+                                 0.38760356f,  0.55983160f,  0.55983160f, 0.38760356f,
+                                 0.16964467f,  0.02988578f,  -0.01026474f, -0.00459480f};
+    static constexpr float gain{1.f};
+};
+
+template <> struct Coefficients<4, 16>
+{
+    static constexpr float h[16]{-0.00134504f, -0.01227398f, -0.03002682f, -0.02533585f,
+                                 0.04705218f,  0.20573990f,  0.40414964f,  0.54414605f,
+                                 0.54414605f,  0.40414964f,  0.20573990f,  0.04705218f,
+                                 -0.02533585f, -0.03002682f, -0.01227398f, -0.00134504f};
+    static constexpr float gain{1.f};
+};
+
+template <> struct Coefficients<2, 1>
+{
+    static constexpr float h[1]{1.f};
+    static constexpr float gain{1.f};
+};
+
+template <> struct Coefficients<2, 4>
+{
+    static constexpr float h[4]{0.00776892f, 0.49223108f, 0.49223108f, 0.00776892f};
+    static constexpr float gain{1.f};
+};
+
+template <int factor, int taps> struct Decimator
+{
+    static_assert(factor > 0 && taps > 0);
+
+    static constexpr int historySize = taps > factor ? taps - factor : 0;
+
+    /**
+     * Produce one output sample from `factor` new sub-samples.
+     *
+     * @param in the sub-samples for this output, oldest first
+     * @param history historySize registers of state, oldest first. Zero them to reset.
+     */
+    static inline SIMD_M128 process(const SIMD_M128 *in, SIMD_M128 *history)
+    {
+        using coeffs = Coefficients<factor, taps>;
+
+        // The taps line up against [history..., in...] with h[taps - 1] on the newest
+        // sample. Split that up by phase so each input register is loaded once per branch.
+        auto res = SIMD_MM(setzero_ps)();
+        for (int p = 0; p < factor; ++p)
+        {
+            // newest-aligned tap index for in[p]
+            const int t0 = taps - factor + p;
+            if (t0 >= 0)
+                res = SIMD_MM(add_ps)(res, SIMD_MM(mul_ps)(in[p], SIMD_MM(set1_ps)(coeffs::h[t0])));
+
+            for (int t = t0 - factor; t >= 0; t -= factor)
+            {
+                res = SIMD_MM(add_ps)(res,
+                                      SIMD_MM(mul_ps)(history[t], SIMD_MM(set1_ps)(coeffs::h[t])));
+            }
+        }
+
+        if constexpr (coeffs::gain != 1.f)
+            res = SIMD_MM(mul_ps)(res, SIMD_MM(set1_ps)(coeffs::gain));
+
+        if constexpr (historySize > 0)
+        {
+            for (int i = 0; i < historySize - factor; ++i)
+                history[i] = history[i + factor];
+            for (int i = std::max(historySize - factor, 0); i < historySize; ++i)
+                history[i] = in[i - historySize + factor];
+        }
+
+        return res;
+    }
+};
+} // namespace sst::filters::PolyphaseDecimator
+
+#endif // SST_FILTERS_POLYPHASEDECIMATOR_H
@@ -0,0 +1,121 @@
+/*
+ * sst-filters - A header-only collection of SIMD filter
+ * implementations by the Surge Synth Team
+ *
+ * Copyright 2019-2025, various authors, as described in the GitHub
+ * transaction log.
+ *
+ * sst-filters is released under the Gnu General Public Licens
+ * version 3 or later. Some of the filters in this package
+ * originated in the version of Surge open sourced in 2018.
+ *
+ * All source in sst-filters available at
+ * https://github.com/surge-synthesizer/sst-filters
+ */
+#ifndef INCLUDE_SST_FILTERS_QUADFILTERSTATEARENA_H
+#define INCLUDE_SST_FILTERS_QUADFILTERSTATEARENA_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "QuadFilterUnit.h"
+#include "FilterUnitTraits.h"
+
+namespace sst::filters
+{
+
+/**
+ * Storage for many QuadFilterUnitStates, for hosts running hundreds or thousands of quads.
+ *
+ * A filter unit only ever touches the coefficients and registers in its FilterUnitTraits, so
+ * an SVF reads three of the state's cache lines and leaves the rest cold. That only holds if
+ * the state starts on a cache line, though; a state at an arbitrary 16 byte boundary spreads
+ * each of those ranges over two lines. The arena keeps every state line aligned in one
+ * contiguous block, so the cache footprint of a quad is just the lines its unit uses, and
+ * resets only clear those.
+ *
+ * ```cpp
+ *     auto arena = QuadFilterStateArena(256);
+ *     arena.setFilterUnit(q, fut_lp12, st_Standard);
+ *     auto fn = GetQFPtrFilterUnit(fut_lp12, st_Standard);
+ *     out = fn(arena.state(q), in);
+ * ```
+ */
+struct QuadFilterStateArena
+{
+    static constexpr size_t cacheLineSize{64};
+
+    explicit QuadFilterStateArena(size_t quads) : slots(quads), slotTraits(quads) {}
+
+    size_t size() const { return slots.size(); }
+
+    QuadFilterUnitState *state(size_t quad)
+    {
+        assert(quad < slots.size());
+        return &slots[quad].state;
+    }
+
+    const FilterUnitTraits &traits(size_t quad) const
+    {
+        assert(quad < slots.size());
+        return slotTraits[quad];
+    }
+
+    /**
+     * Record the unit a quad runs. This clears all of the quad's registers, since the
+     * previous unit may have used ones the new one does not.
+     */
+    void setFilterUnit(size_t quad, FilterType type, FilterSubType subtype)
+    {
+        assert(quad < slots.size());
+        slotTraits[quad] = FilterUnitTraits{};
+        reset(quad);
+        slotTraits[quad] = GetFilterUnitTraits(type, subtype);
+    }
+
+    /** Clear the registers and comb write positions the quad's unit uses. */
+    void reset(size_t quad)
+    {
+        auto &s = slots[quad].state;
+        std::fill(s.R, &s.R[slotTraits[quad].registers], SIMD_MM(setzero_ps)());
+        if (slotTraits[quad].delayLineSize > 0)
+            std::fill(s.WP, &s.WP[4], 0);
+    }
+
+    /**
+     * The bytes of coefficient, delta and register lines a unit touches in a line aligned
+     * state. A few units also read the voice mask, delay line pointers or sample rate at the
+     * end of the state, which adds a line or two.
+     */
+    static constexpr size_t liveBytesFor(const FilterUnitTraits &t)
+    {
+        auto lines = [](size_t n) {
+            return (n * sizeof(SIMD_M128) + cacheLineSize - 1) / cacheLineSize;
+        };
+        return (2 * lines(t.coefficients) + lines(t.registers)) * cacheLineSize;
+    }
+
+    /** The live bytes across the whole arena, the working set of running every quad. */
+    size_t liveBytes() const
+    {
+        size_t res{0};
+        for (const auto &t : slotTraits)
+            res += liveBytesFor(t);
+        return res;
+    }
+
+  protected:
+    struct alignas(cacheLineSize) Slot
+    {
+        QuadFilterUnitState state{};
+    };
+    static_assert(sizeof(Slot) % cacheLineSize == 0);
+
+    std::vector<Slot> slots;
+    std::vector<FilterUnitTraits> slotTraits;
+};
+} // namespace sst::filters
+
+#endif // SST_FILTERS_QUADFILTERSTATEARENA_H
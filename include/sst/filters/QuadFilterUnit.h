@@ -63,8 +63,8 @@ typedef SIMD_M128 (*FilterUnitQFPtr)(QuadFilterUnitState *__restrict, SIMD_M128
  * But really it's just some constants we bodge in to turn up vintage and turn down
  * saturated ones.
  */
-template <bool Compensate>
-FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubType subtype);
+template <bool Compensate, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
+constexpr FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubType subtype);
 
 /** Returns a filter unit pointer for a given filter type and sub-type. */
 inline FilterUnitQFPtr GetQFPtrFilterUnit(FilterType type, FilterSubType subtype)
@@ -72,6 +72,26 @@ inline FilterUnitQFPtr GetQFPtrFilterUnit(FilterType type, FilterSubType subtype
     return GetCompensatedQFPtrFilterUnit<false>(type, subtype);
 }
 
+/**
+ * Returns a filter unit pointer for a given filter type and sub-type whose
+ * saturators run at the given accuracy. Models without an approximated
+ * nonlinearity return the same unit for every accuracy.
+ */
+inline FilterUnitQFPtr GetQFPtrFilterUnit(FilterType type, FilterSubType subtype,
+                                          NonlinearityAccuracy accuracy)
+{
+    switch (accuracy)
+    {
+    case NonlinearityAccuracy::Cheap:
+        return GetCompensatedQFPtrFilterUnit<false, NonlinearityAccuracy::Cheap>(type, subtype);
+    case NonlinearityAccuracy::Accurate:
+        return GetCompensatedQFPtrFilterUnit<false, NonlinearityAccuracy::Accurate>(type, subtype);
+    case NonlinearityAccuracy::Standard:
+    default:
+        return GetCompensatedQFPtrFilterUnit<false>(type, subtype);
+    }
+}
+
 } // namespace filters
 } // namespace sst
 
@@ -667,8 +667,8 @@ SIMD_M128 ScaleQFPtr(QuadFilterUnitState *__restrict s, SIMD_M128 in)
     return SIMD_MM(mul_ps)(res, scale);
 }
 
-template <bool Compensated>
-inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubType subtype)
+template <bool Compensated, NonlinearityAccuracy accuracy>
+constexpr FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubType subtype)
 {
     switch (type)
     {
@@ -812,15 +812,16 @@ inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubT
         case st_vintage_type1_compensated:
             if constexpr (Compensated)
                 // Scale up by 6dB = 1.994 amplitudes
-                return ScaleQFPtr<1994, VintageLadder::RK::process>;
+                return ScaleQFPtr<1994, VintageLadder::RK::process<>>;
             else
-                return VintageLadder::RK::process;
+                return VintageLadder::RK::process<>;
         case st_vintage_type2:
         case st_vintage_type2_compensated:
-            return VintageLadder::Huov::process;
+            return VintageLadder::Huov::process<VintageLadder::Huov::defaultDecimatorTaps,
+                                                accuracy>;
         case st_vintage_type3:
         case st_vintage_type3_compensated:
-            return VintageLadder::Huov2010::process;
+            return VintageLadder::Huov2010::process<accuracy>;
         default:
             break;
         }
@@ -893,12 +894,12 @@ inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubT
 
     case fut_k35_lp:
         if (Compensated && subtype == 2)
-            return ScaleQFPtr<0700, K35Filter::process_lp>;
+            return ScaleQFPtr<0700, K35Filter::process_lp<accuracy>>;
         else
-            return K35Filter::process_lp;
+            return K35Filter::process_lp<accuracy>;
         break;
     case fut_k35_hp:
-        return K35Filter::process_hp;
+        return K35Filter::process_hp<accuracy>;
         break;
     case fut_diode:
         switch (subtype)
@@ -923,32 +924,32 @@ inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubT
         switch (subtype)
         {
         case st_cutoffwarp_tanh1:
-            return CutoffWarp::process<st_cutoffwarp_tanh1>;
+            return CutoffWarp::process<st_cutoffwarp_tanh1, accuracy>;
         case st_cutoffwarp_tanh2:
-            return CutoffWarp::process<st_cutoffwarp_tanh2>;
+            return CutoffWarp::process<st_cutoffwarp_tanh2, accuracy>;
         case st_cutoffwarp_tanh3:
-            return CutoffWarp::process<st_cutoffwarp_tanh3>;
+            return CutoffWarp::process<st_cutoffwarp_tanh3, accuracy>;
         case st_cutoffwarp_tanh4:
-            return CutoffWarp::process<st_cutoffwarp_tanh4>;
+            return CutoffWarp::process<st_cutoffwarp_tanh4, accuracy>;
         case st_cutoffwarp_softclip1:
-            return CutoffWarp::process<st_cutoffwarp_softclip1>;
+            return CutoffWarp::process<st_cutoffwarp_softclip1, accuracy>;
         case st_cutoffwarp_softclip2:
-            return CutoffWarp::process<st_cutoffwarp_softclip2>;
+            return CutoffWarp::process<st_cutoffwarp_softclip2, accuracy>;
         case st_cutoffwarp_softclip3:
-            return CutoffWarp::process<st_cutoffwarp_softclip3>;
+            return CutoffWarp::process<st_cutoffwarp_softclip3, accuracy>;
         case st_cutoffwarp_softclip4:
-            return CutoffWarp::process<st_cutoffwarp_softclip4>;
+            return CutoffWarp::process<st_cutoffwarp_softclip4, accuracy>;
         case st_cutoffwarp_ojd1:
-            return CutoffWarp::process<st_cutoffwarp_ojd1>;
+            return CutoffWarp::process<st_cutoffwarp_ojd1, accuracy>;
         case st_cutoffwarp_ojd2:
-            return CutoffWarp::process<st_cutoffwarp_ojd2>;
+            return CutoffWarp::process<st_cutoffwarp_ojd2, accuracy>;
         case st_cutoffwarp_ojd3:
             if constexpr (Compensated)
-                return ScaleQFPtr<0400, CutoffWarp::process<st_cutoffwarp_ojd3>>;
+                return ScaleQFPtr<0400, CutoffWarp::process<st_cutoffwarp_ojd3, accuracy>>;
             else
-                return CutoffWarp::process<st_cutoffwarp_ojd3>;
+                return CutoffWarp::process<st_cutoffwarp_ojd3, accuracy>;
         case st_cutoffwarp_ojd4:
-            return CutoffWarp::process<st_cutoffwarp_ojd4>;
+            return CutoffWarp::process<st_cutoffwarp_ojd4, accuracy>;
         default:
             break;
         }
@@ -961,24 +962,24 @@ inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubT
         switch (subtype)
         {
         case st_resonancewarp_tanh1:
-            return ResonanceWarp::process<st_resonancewarp_tanh1>;
+            return ResonanceWarp::process<st_resonancewarp_tanh1, accuracy>;
         case st_resonancewarp_tanh2:
-            return ResonanceWarp::process<st_resonancewarp_tanh2>;
+            return ResonanceWarp::process<st_resonancewarp_tanh2, accuracy>;
         case st_resonancewarp_tanh3:
-            return ResonanceWarp::process<st_resonancewarp_tanh3>;
+            return ResonanceWarp::process<st_resonancewarp_tanh3, accuracy>;
         case st_resonancewarp_tanh4:
             if constexpr (Compensated)
-                return ScaleQFPtr<1584, ResonanceWarp::process<st_resonancewarp_tanh4>>;
+                return ScaleQFPtr<1584, ResonanceWarp::process<st_resonancewarp_tanh4, accuracy>>;
             else
-                return ResonanceWarp::process<st_resonancewarp_tanh4>;
+                return ResonanceWarp::process<st_resonancewarp_tanh4, accuracy>;
         case st_resonancewarp_softclip1:
-            return ResonanceWarp::process<st_resonancewarp_softclip1>;
+            return ResonanceWarp::process<st_resonancewarp_softclip1, accuracy>;
         case st_resonancewarp_softclip2:
-            return ResonanceWarp::process<st_resonancewarp_softclip2>;
+            return ResonanceWarp::process<st_resonancewarp_softclip2, accuracy>;
         case st_resonancewarp_softclip3:
-            return ResonanceWarp::process<st_resonancewarp_softclip3>;
+            return ResonanceWarp::process<st_resonancewarp_softclip3, accuracy>;
         case st_resonancewarp_softclip4:
-            return ResonanceWarp::process<st_resonancewarp_softclip4>;
+            return ResonanceWarp::process<st_resonancewarp_softclip4, accuracy>;
         default:
             break;
         }
@@ -987,29 +988,29 @@ inline FilterUnitQFPtr GetCompensatedQFPtrFilterUnit(FilterType type, FilterSubT
         switch (subtype)
         {
         case st_tripole_LLL1:
-            return TriPoleFilter::process<st_tripole_LLL1>;
+            return TriPoleFilter::process<st_tripole_LLL1, accuracy>;
         case st_tripole_LHL1:
-            return TriPoleFilter::process<st_tripole_LHL1>;
+            return TriPoleFilter::process<st_tripole_LHL1, accuracy>;
         case st_tripole_HLH1:
-            return TriPoleFilter::process<st_tripole_HLH1>;
+            return TriPoleFilter::process<st_tripole_HLH1, accuracy>;
         case st_tripole_HHH1:
-            return TriPoleFilter::process<st_tripole_HHH1>;
+            return TriPoleFilter::process<st_tripole_HHH1, accuracy>;
         case st_tripole_LLL2:
-            return TriPoleFilter::process<st_tripole_LLL2>;
+            return TriPoleFilter::process<st_tripole_LLL2, accuracy>;
         case st_tripole_LHL2:
-            return TriPoleFilter::process<st_tripole_LHL2>;
+            return TriPoleFilter::process<st_tripole_LHL2, accuracy>;
         case st_tripole_HLH2:
-            return TriPoleFilter::process<st_tripole_HLH2>;
+            return TriPoleFilter::process<st_tripole_HLH2, accuracy>;
         case st_tripole_HHH2:
-            return TriPoleFilter::process<st_tripole_HHH2>;
+            return TriPoleFilter::process<st_tripole_HHH2, accuracy>;
         case st_tripole_LLL3:
-            return TriPoleFilter::process<st_tripole_LLL3>;
+            return TriPoleFilter::process<st_tripole_LLL3, accuracy>;
         case st_tripole_LHL3:
-            return TriPoleFilter::process<st_tripole_LHL3>;
+            return TriPoleFilter::process<st_tripole_LHL3, accuracy>;
         case st_tripole_HLH3:
-            return TriPoleFilter::process<st_tripole_HLH3>;
+            return TriPoleFilter::process<st_tripole_HLH3, accuracy>;
         case st_tripole_HHH3:
-            return TriPoleFilter::process<st_tripole_HHH3>;
+            return TriPoleFilter::process<st_tripole_HHH3, accuracy>;
         default:
             break;
         }
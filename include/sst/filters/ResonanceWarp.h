@@ -19,6 +19,7 @@
 #include "FilterCoefficientMaker.h"
 #include "sst/basic-blocks/dsp/FastMath.h"
 #include "sst/basic-blocks/dsp/Clippers.h"
+#include "Nonlinearity.h"
 
 /**
  * This contains an adaptation of the filter found at
@@ -52,6 +53,7 @@ enum Saturator
     SAT_SOFT
 };
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 doNLFilter(const SIMD_M128 input, const SIMD_M128 a1, const SIMD_M128 a2,
                                    const SIMD_M128 b0, const SIMD_M128 b1, const SIMD_M128 b2,
                                    const int sat, SIMD_M128 &z1, SIMD_M128 &z2) noexcept
@@ -68,8 +70,8 @@ static inline SIMD_M128 doNLFilter(const SIMD_M128 input, const SIMD_M128 a1, co
     switch (sat)
     {
     case SAT_TANH:
-        z1 = basic_blocks::dsp::fasttanhSSEclamped(z1);
-        z2 = basic_blocks::dsp::fasttanhSSEclamped(z2);
+        z1 = Nonlinearity::tanh<accuracy>(z1);
+        z2 = Nonlinearity::tanh<accuracy>(z2);
         break;
     default:
         z1 = basic_blocks::dsp::softclip_ps(
@@ -157,7 +159,7 @@ void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float freq, fl
     cm->FromDirect(C);
 }
 
-template <FilterSubType subtype>
+template <FilterSubType subtype, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 {
     // lower 2 bits of subtype is the stage count
@@ -168,8 +170,9 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
     // n.b. stages is zero-indexed so use <=
     for (int stage = 0; stage <= stages; ++stage)
     {
-        input = doNLFilter(input, f->C[nls_a1], f->C[nls_a2], f->C[nls_b0], f->C[nls_b1],
-                           f->C[nls_b2], sat, f->R[nls_z1 + stage * 2], f->R[nls_z2 + stage * 2]);
+        input = doNLFilter<accuracy>(input, f->C[nls_a1], f->C[nls_a2], f->C[nls_b0], f->C[nls_b1],
+                                     f->C[nls_b2], sat, f->R[nls_z1 + stage * 2],
+                                     f->R[nls_z2 + stage * 2]);
     }
 
     for (int i = 0; i < n_nls_coeff; ++i)
@@ -15,10 +15,12 @@
 #ifndef INCLUDE_SST_FILTERS_TRIPOLEFILTER_H
 #define INCLUDE_SST_FILTERS_TRIPOLEFILTER_H
 
+#include <cstdint>
 #include "QuadFilterUnit.h"
 #include "FilterCoefficientMaker.h"
 #include "sst/basic-blocks/dsp/FastMath.h"
 #include "sst/basic-blocks/mechanics/simd-ops.h"
+#include "Nonlinearity.h"
 
 /**
  * This filter is an emulation of the "Threeler" VCF by
@@ -44,6 +46,39 @@ constexpr float out_gain = 1.0f / in_gain;
 constexpr int nIterGlobal = 3;
 constexpr int nIterStage = 1;
 
+/*
+ * The global feedback solver can optionally stop early, once the Newton step on every
+ * active lane is smaller than convergenceEpsilon. It never runs more than nIterGlobal
+ * iterations, so the worst case cost is the same as the fixed solver. Quiet or low
+ * resonance material typically converges after the first iteration. Define
+ * SST_FILTERS_TRIPOLE_ADAPTIVE_SOLVER to 1 to make process<> use it, or call
+ * processAdaptive<> directly.
+ */
+#ifndef SST_FILTERS_TRIPOLE_ADAPTIVE_SOLVER
+#define SST_FILTERS_TRIPOLE_ADAPTIVE_SOLVER 0
+#endif
+
+constexpr bool adaptiveSolverByDefault = SST_FILTERS_TRIPOLE_ADAPTIVE_SOLVER;
+constexpr float convergenceEpsilon = 1.0e-5f;
+
+/** Optional iteration count statistics for the adaptive solver */
+struct SolverStats
+{
+    uint64_t samples{0};
+    uint64_t iterations{0};
+
+    float averageIterations() const
+    {
+        return samples == 0 ? 0.f : (float)((double)iterations / (double)samples);
+    }
+
+    void reset()
+    {
+        samples = 0;
+        iterations = 0;
+    }
+};
+
 // each OTA is a little different :)
 constexpr float ota1bp = 0.88f;
 constexpr float ota1bn = 1.0f;
@@ -75,14 +110,22 @@ static float clampedFrequency(float pitch, float sampleRate, TuningProvider *pro
 #define N(a) S(F(0.0f), a)
 
 /** inverse square root sigmoid */
+template <NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 static inline SIMD_M128 thr_sigmoid(SIMD_M128 x, float beta)
 {
     auto vtmp = SIMD_MM(mul_ps)(x, x);           // calculate in*in
     auto vtmp2 = SIMD_MM(add_ps)(vtmp, F(beta)); // in*in+1.f
-    vtmp = SIMD_MM(rsqrt_ps)(vtmp2);             // 1/sqrt(in*in+1.f)
+    vtmp = Nonlinearity::rsqrt<accuracy>(vtmp2); // 1/sqrt(in*in+1.f)
     return SIMD_MM(mul_ps)(vtmp, x);             // in*1/sqrt(in*in+1)
 }
 
+/** true if |step| <= eps on every lane set in activeMask */
+static inline bool lanesConverged(SIMD_M128 step, SIMD_M128 eps, SIMD_M128 activeMask)
+{
+    auto notConverged = SIMD_MM(cmpgt_ps)(basic_blocks::mechanics::abs_ps(step), eps);
+    return SIMD_MM(movemask_ps)(SIMD_MM(and_ps)(notConverged, activeMask)) == 0;
+}
+
 static inline SIMD_M128 sech2_with_tanh(SIMD_M128 tanh_value)
 {
     const auto one = F(1.0f);
@@ -113,13 +156,14 @@ static inline SIMD_M128 getXDerivative(SIMD_M128 tanh_x, SIMD_M128 b_coeff)
     return M(b_coeff, sech2_with_tanh(tanh_x));
 }
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 process(SIMD_M128 tanh_x, SIMD_M128 z, SIMD_M128 estimate,
                                 SIMD_M128 b_coeff, SIMD_M128 a_coeff, float beta)
 {
     estimate = linOutput(tanh_x, z, b_coeff, a_coeff);
     for (int i = 0; i < nIterStage; ++i)
     {
-        auto tanh_y = thr_sigmoid(estimate, beta);
+        auto tanh_y = thr_sigmoid<accuracy>(estimate, beta);
         auto residue = S(nonlinOutput(tanh_x, tanh_y, z, b_coeff), estimate);
         estimate = S(estimate, D(residue, getDerivative(tanh_y, b_coeff)));
     }
@@ -149,6 +193,7 @@ static inline SIMD_M128 getDerivative(SIMD_M128 tanh_y, SIMD_M128 b_coeff)
 
 static inline SIMD_M128 getXDerivative() { return F(2.0f); }
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 process(SIMD_M128 x, SIMD_M128 x1, SIMD_M128 z, SIMD_M128 estimate,
                                 SIMD_M128 b_coeff, SIMD_M128 a_coeff, float beta)
 {
@@ -156,7 +201,7 @@ static inline SIMD_M128 process(SIMD_M128 x, SIMD_M128 x1, SIMD_M128 z, SIMD_M12
     estimate = linOutput(x_minus_x1_plus_z, a_coeff);
     for (int i = 0; i < nIterStage; ++i)
     {
-        auto tanh_y = thr_sigmoid(estimate, beta);
+        auto tanh_y = thr_sigmoid<accuracy>(estimate, beta);
         auto residue = S(nonlinOutput(x_minus_x1_plus_z, tanh_y, b_coeff), estimate);
         estimate = S(estimate, D(residue, getDerivative(tanh_y, b_coeff)));
     }
@@ -189,6 +234,7 @@ static inline SIMD_M128 getXDerivative()
     return two;
 }
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 process(SIMD_M128 tanh_x, SIMD_M128 z, SIMD_M128 fb, SIMD_M128 fb1,
                                 SIMD_M128 estimate, SIMD_M128 b_coeff, SIMD_M128 a_coeff,
                                 SIMD_M128 bx)
@@ -197,7 +243,7 @@ static inline SIMD_M128 process(SIMD_M128 tanh_x, SIMD_M128 z, SIMD_M128 fb, SIM
     estimate = linOutput(bx, z_minus_fb_plus_fb1, a_coeff);
     for (int i = 0; i < nIterStage; ++i)
     {
-        auto tanh_y = thr_sigmoid(estimate, ota1bn);
+        auto tanh_y = thr_sigmoid<accuracy>(estimate, ota1bn);
         auto residue = S(nonlinOutput(tanh_x, tanh_y, z_minus_fb_plus_fb1, b_coeff), estimate);
         estimate = S(estimate, D(residue, getDerivative(tanh_y, b_coeff)));
     }
@@ -231,13 +277,14 @@ static inline SIMD_M128 getFBDerivative(SIMD_M128 tanh_fb, SIMD_M128 b_coeff)
     return M(b_coeff, sech2_with_tanh(tanh_fb));
 }
 
+template <NonlinearityAccuracy accuracy>
 static inline SIMD_M128 process(SIMD_M128 x_minus_x1_plus_z, SIMD_M128 tanh_fb, SIMD_M128 estimate,
                                 SIMD_M128 b_coeff, SIMD_M128 a_coeff)
 {
     estimate = linOutput(x_minus_x1_plus_z, tanh_fb, a_coeff, b_coeff);
     for (int i = 0; i < nIterStage; ++i)
     {
-        auto tanh_y = thr_sigmoid(estimate, ota1bn);
+        auto tanh_y = thr_sigmoid<accuracy>(estimate, ota1bn);
         auto residue = S(nonlinOutput(x_minus_x1_plus_z, tanh_y, tanh_fb, b_coeff), estimate);
         estimate = S(estimate, D(residue, getDerivative(tanh_y, b_coeff)));
     }
@@ -359,8 +406,8 @@ void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float freq, fl
     cm->FromDirect(C);
 }
 
-template <FilterSubType subtype>
-inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
+template <FilterSubType subtype, bool adaptive, NonlinearityAccuracy accuracy>
+inline SIMD_M128 processImpl(QuadFilterUnitState *__restrict f, SIMD_M128 in, SolverStats *stats)
 {
     // input gain
     in = M(F(in_gain), in);
@@ -400,7 +447,7 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
     {
     case 0: // lowpass
     case 1:
-        tanh_x0 = thr_sigmoid(in, ota1bp);
+        tanh_x0 = thr_sigmoid<accuracy>(in, ota1bp);
         bx = M(b0, tanh_x0);
         break;
     case 2: // highpass
@@ -411,7 +458,18 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
     };
     auto estimate = f->R[thr_fb];
 
+    SIMD_M128 activeMask, eps;
+    if constexpr (adaptive)
+    {
+        // active is only guaranteed non-zero, not all bits set, so build a proper lane mask
+        auto act = SIMD_MM(loadu_si128)((const SIMD_M128I *)f->active);
+        activeMask = SIMD_MM(castsi128_ps)(SIMD_MM(cmpeq_epi32)(act, SIMD_MM(setzero_si128)()));
+        activeMask = SIMD_MM(xor_ps)(activeMask, SIMD_MM(castsi128_ps)(SIMD_MM(set1_epi32)(-1)));
+        eps = F(convergenceEpsilon);
+    }
+
     // global feedback iteration
+    int iterations = 0;
     for (int i = 0; i < nIterGlobal; ++i)
     {
         // filter stage 1 (with feedback input)
@@ -419,14 +477,14 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
         {
         case 0: // lowpass
         case 1:
-            estimate0 =
-                OnePoleLPF_FB::process(tanh_x0, z0, estimate, f->R[thr_fb1], estimate0, b0, a0, bx);
+            estimate0 = OnePoleLPF_FB::process<accuracy>(tanh_x0, z0, estimate, f->R[thr_fb1],
+                                                         estimate0, b0, a0, bx);
             f0_deriv = OnePoleLPF_FB::getXDerivative();
             break;
         case 2: // highpass
         case 3:
-            tanh_fb = thr_sigmoid(estimate, ota1bp);
-            estimate0 = OnePoleHPF_FB::process(hpf_in, tanh_fb, estimate0, b0, a0);
+            tanh_fb = thr_sigmoid<accuracy>(estimate, ota1bp);
+            estimate0 = OnePoleHPF_FB::process<accuracy>(hpf_in, tanh_fb, estimate0, b0, a0);
             f0_deriv = OnePoleHPF_FB::getFBDerivative(tanh_fb, b0);
             break;
         };
@@ -436,13 +494,14 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
         {
         case 0: // lowpass
         case 2:
-            tanh_x1 = thr_sigmoid(estimate0, ota2bp);
-            estimate1 = OnePoleLPF::process(tanh_x1, z1, estimate1, b1, a1, ota2bn);
+            tanh_x1 = thr_sigmoid<accuracy>(estimate0, ota2bp);
+            estimate1 = OnePoleLPF::process<accuracy>(tanh_x1, z1, estimate1, b1, a1, ota2bn);
             f1_deriv = OnePoleLPF::getXDerivative(tanh_x1, b1);
             break;
         case 1: // highpass
         case 3:
-            estimate1 = OnePoleHPF::process(estimate0, x1, z1, estimate1, b1, a1, ota2bn);
+            estimate1 =
+                OnePoleHPF::process<accuracy>(estimate0, x1, z1, estimate1, b1, a1, ota2bn);
             f1_deriv = OnePoleHPF::getXDerivative();
             break;
         };
@@ -457,20 +516,34 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
         {
         case 0: // lowpass
         case 1:
-            tanh_x2 = thr_sigmoid(res_out, ota3bp);
-            estimate2 = OnePoleLPF::process(tanh_x2, z2, estimate2, b2, a2, ota3bn);
+            tanh_x2 = thr_sigmoid<accuracy>(res_out, ota3bp);
+            estimate2 = OnePoleLPF::process<accuracy>(tanh_x2, z2, estimate2, b2, a2, ota3bn);
             f2_deriv = OnePoleLPF::getXDerivative(tanh_x2, b2);
             break;
         case 2:
         case 3:
-            estimate2 = OnePoleHPF::process(res_out, x2, z2, estimate2, b2, a2, ota3bn);
+            estimate2 = OnePoleHPF::process<accuracy>(res_out, x2, z2, estimate2, b2, a2, ota3bn);
             f2_deriv = OnePoleHPF::getXDerivative();
             break;
         };
 
         auto num = S(estimate, estimate2);
         auto den = S(F(1.0f), M(k_ps, M(res_deriv, M(f0_deriv, M(f1_deriv, f2_deriv)))));
-        estimate = S(estimate, D(num, den));
+        auto step = D(num, den);
+        estimate = S(estimate, step);
+        iterations++;
+
+        if constexpr (adaptive)
+        {
+            if (lanesConverged(step, eps, activeMask))
+                break;
+        }
+    }
+
+    if (stats)
+    {
+        stats->samples++;
+        stats->iterations += iterations;
     }
 
     // update filter state
@@ -500,6 +573,30 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
     };
 }
 
+template <FilterSubType subtype, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
+inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
+{
+    return processImpl<subtype, adaptiveSolverByDefault, accuracy>(f, in, nullptr);
+}
+
+/**
+ * The tolerance driven version of process. This has the FilterUnitQFPtr signature
+ * so can be used in place of process<subtype> as a filter unit.
+ */
+template <FilterSubType subtype, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
+inline SIMD_M128 processAdaptive(QuadFilterUnitState *__restrict f, SIMD_M128 in)
+{
+    return processImpl<subtype, true, accuracy>(f, in, nullptr);
+}
+
+/** As above, accumulating the iterations used into stats */
+template <FilterSubType subtype, NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
+inline SIMD_M128 processAdaptive(QuadFilterUnitState *__restrict f, SIMD_M128 in,
+                                 SolverStats &stats)
+{
+    return processImpl<subtype, true, accuracy>(f, in, &stats);
+}
+
 #undef F
 #undef M
 #undef D
@@ -19,6 +19,8 @@
 #include "sst/basic-blocks/dsp/FastMath.h"
 #include "QuadFilterUnit.h"
 #include "FilterCoefficientMaker.h"
+#include "PolyphaseDecimator.h"
+#include "Nonlinearity.h"
 
 /**
  * This contains various adaptations of the models found at
@@ -119,6 +121,20 @@ static constexpr float saturation = 3.0f, saturationInverse = 0.333333333333f;
 
 static constexpr float gainCompensation = 0.666f;
 
+/*
+ * The extraOversample substeps are reconstructed with a PolyphaseDecimator. The 4 tap
+ * default is the original Lanczos reconstruction; 8, 12 or 16 taps trade CPU for less
+ * aliasing. The longer kernels keep their history in R[decimatorHistory...], after the
+ * four ladder states.
+ */
+#ifndef SST_FILTERS_VINTAGE_LADDER_RK_DECIMATOR_TAPS
+#define SST_FILTERS_VINTAGE_LADDER_RK_DECIMATOR_TAPS 4
+#endif
+
+static constexpr int defaultDecimatorTaps = SST_FILTERS_VINTAGE_LADDER_RK_DECIMATOR_TAPS;
+static constexpr int decimatorHistory = 4;
+using default_decimator_t = PolyphaseDecimator::Decimator<extraOversample, defaultDecimatorTaps>;
+
 template <typename TuningProvider>
 inline void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float freq, float reso,
                              float sampleRate, bool applyGainCompensation, TuningProvider *provider)
@@ -183,8 +199,12 @@ inline void calculateDerivatives(SIMD_M128 input, SIMD_M128 *dstate, SIMD_M128 *
     dstate[3] = M(cutoff, S(satstate2, clip(state[3], _saturation, _saturationInv)));
 }
 
+template <int decimatorTaps = defaultDecimatorTaps>
 inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
 {
+    using decimator_t = PolyphaseDecimator::Decimator<extraOversample, decimatorTaps>;
+    static_assert(decimatorHistory + decimator_t::historySize <= n_filter_registers);
+
     int i;
     SIMD_M128 deriv1[4], deriv2[4], deriv3[4], deriv4[4], tempState[4];
 
@@ -244,30 +264,7 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 input)
         input = SIMD_MM(setzero_ps)();
     }
 
-    /*
-    ** OK this is a bit of a hack but... these are the Lanczos factors
-    ** sinc( x ) sinc (x / 2), only backwards. Really we should do a proper little
-    ** FIR around the whole thing, but this at least gives us a reconstruction with
-    ** some aliasing supression.
-    **
-    ** Not entirely valid but...
-    **
-    ** Anyway: (2 * sin(pi * x) * sin((pi * x) / 2)) / (pi^2 * x^2), for points -1.5, -1, 0.5, and 0
-    **
-    */
-    auto ov = SIMD_MM(setzero_ps)();
-    SIMD_M128 windowFactors[4];
-    windowFactors[0] = F(-0.0636844f);
-    windowFactors[1] = SIMD_MM(setzero_ps)();
-    windowFactors[2] = F(0.57315917f);
-    windowFactors[3] = F(1);
-
-    for (int k = 0; k < extraOversample; ++k)
-    {
-        ov = A(ov, M(outputOS[k], windowFactors[k]));
-    }
-
-    return M(F(1.5), ov);
+    return decimator_t::process(outputOS, &(f->R[decimatorHistory]));
 }
 
 #undef F
@@ -316,10 +313,22 @@ enum huov_regoffsets
     h_stage = 0,
     h_stageTanh = 4,
     h_delay = 7,
+    h_decimator = 13,
 };
 
 static constexpr float gainCompensation = 0.5;
 
+/*
+ * The 2x substeps go through a PolyphaseDecimator. The 1 tap default just keeps the
+ * second substep, which is what this model has always done; 4 taps filters them.
+ */
+#ifndef SST_FILTERS_VINTAGE_LADDER_HUOV_DECIMATOR_TAPS
+#define SST_FILTERS_VINTAGE_LADDER_HUOV_DECIMATOR_TAPS 1
+#endif
+
+static constexpr int defaultDecimatorTaps = SST_FILTERS_VINTAGE_LADDER_HUOV_DECIMATOR_TAPS;
+using default_decimator_t = PolyphaseDecimator::Decimator<2, defaultDecimatorTaps>;
+
 template <typename TuningProvider>
 inline void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float freq, float reso,
                              float sampleRate, float sampleRateInv, bool applyGainCompensation,
@@ -348,8 +357,13 @@ inline void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float f
     cm->FromDirect(lC);
 }
 
+template <int decimatorTaps = defaultDecimatorTaps,
+          NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
 {
+    using decimator_t = PolyphaseDecimator::Decimator<2, decimatorTaps>;
+    static_assert(h_decimator + decimator_t::historySize <= n_filter_registers);
+
 #define F(a) SIMD_MM(set_ps1)(a)
 #define M(a, b) SIMD_MM(mul_ps)(a, b)
 #define A(a, b) SIMD_MM(add_ps)(a, b)
@@ -392,7 +406,7 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
 
         // delay[0] = stage[0] = delay[0] + tune * (tanh(input * thermal) - stageTanh[0]);
         f->R[h_stage + 0] =
-            A(f->R[h_delay + 0], M(tune, S(basic_blocks::dsp::fasttanhSSEclamped(M(input, thermal)),
+            A(f->R[h_delay + 0], M(tune, S(Nonlinearity::tanh<accuracy>(M(input, thermal)),
                                            f->R[h_stageTanh + 0])));
         f->R[h_delay + 0] = f->R[h_stage + 0];
 
@@ -403,11 +417,11 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
 
             // stage[k] = delay[k] + tune * ((stageTanh[k-1] = tanh(input * thermal)) - (k != 3 ?
             // stageTanh[k] : tanh(delay[k] * thermal)));
-            f->R[h_stageTanh + k - 1] = basic_blocks::dsp::fasttanhSSEclamped(M(input, thermal));
+            f->R[h_stageTanh + k - 1] = Nonlinearity::tanh<accuracy>(M(input, thermal));
             f->R[h_stage + k] =
                 A(f->R[h_delay + k], M(tune, S(f->R[h_stageTanh + k - 1],
                                                (k != 3 ? f->R[h_stageTanh + k]
-                                                       : basic_blocks::dsp::fasttanhSSEclamped(
+                                                       : Nonlinearity::tanh<accuracy>(
                                                              M(f->R[h_delay + k], thermal))))));
 
             // delay[k] = stage[k];
@@ -424,7 +438,7 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
         outputOS[j] = f->R[h_delay + 5];
     }
 
-    return outputOS[1];
+    return decimator_t::process(outputOS, &(f->R[h_decimator]));
 #undef M
 #undef A
 #undef S
@@ -469,11 +483,12 @@ inline void makeCoefficients(FilterCoefficientMaker<TuningProvider> *cm, float f
 #define A(a, b) SIMD_MM(add_ps)(a, b)
 #define S(a, b) SIMD_MM(sub_ps)(a, b)
 
+template <NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 nonlin(SIMD_M128 in)
 {
     static constexpr float sc{70.f};
     static const SIMD_M128 th(F(1.0 / sc)), ith(F(sc));
-    return M(ith, sst::basic_blocks::dsp::fasttanhSSEclamped(M(in, th)));
+    return M(ith, Nonlinearity::tanh<accuracy>(M(in, th)));
 }
 
 inline SIMD_M128 onePole(int idx, QuadFilterUnitState *__restrict f, SIMD_M128 in)
@@ -492,6 +507,7 @@ inline SIMD_M128 onePole(int idx, QuadFilterUnitState *__restrict f, SIMD_M128 i
     return n3;
 }
 
+template <NonlinearityAccuracy accuracy = NonlinearityAccuracy::Standard>
 inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
 {
     static constexpr float driveFactor{4.0};
@@ -499,7 +515,7 @@ inline SIMD_M128 process(QuadFilterUnitState *__restrict f, SIMD_M128 in)
     auto zm1 = f->R[h_delayLine];
     auto gaincomp = A(zm1, M(f->C[h_gcomp], M(inDrive, in)));
     auto fb = M(f->C[h_gres], gaincomp);
-    auto n1 = nonlin(S(M(inDrive, in), fb));
+    auto n1 = nonlin<accuracy>(S(M(inDrive, in), fb));
     auto s1 = onePole(0, f, n1);
     auto s2 = onePole(1, f, s1);
     auto s3 = onePole(2, f, s2);
@@ -281,3 +281,64 @@ TEST_CASE("Basic Filters")
                 {-5.81567f, -2.17117f, -6.19879f, -4.28433f, -8.0815f});
     }
 }
+
+TEST_CASE("Quad Filter State Arena")
+{
+    using namespace TestUtils;
+    using sst::filters::QuadFilterStateArena;
+
+    auto arena = QuadFilterStateArena(33);
+    REQUIRE(arena.size() == 33);
+    for (size_t q = 0; q < arena.size(); ++q)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(arena.state(q));
+        REQUIRE(addr % QuadFilterStateArena::cacheLineSize == 0);
+        // the initial state is the whole state, until a unit is set
+        REQUIRE(arena.traits(q).registers == sst::filters::n_filter_registers);
+    }
+
+    SECTION("Footprint Follows The Unit")
+    {
+        static_assert(QuadFilterStateArena::liveBytesFor(sst::filters::GetFilterUnitTraits(
+                          FilterType::fut_lp12, FilterSubType::st_Standard)) == 3 * 64);
+
+        for (size_t q = 0; q < arena.size(); ++q)
+            arena.setFilterUnit(q, FilterType::fut_lp12, FilterSubType::st_Standard);
+        REQUIRE(arena.liveBytes() == arena.size() * 3 * 64);
+
+        arena.setFilterUnit(0, FilterType::fut_vintageladder, FilterSubType::st_vintage_type2);
+        REQUIRE(arena.liveBytes() == (arena.size() - 1) * 3 * 64 + (2 * 1 + 4) * 64);
+    }
+
+    SECTION("Arena States Run Like Any Other")
+    {
+        auto type = FilterType::fut_k35_lp;
+        auto subtype = FilterSubType::st_k35_mild;
+        auto fn = sst::filters::GetQFPtrFilterUnit(type, subtype);
+
+        sst::filters::FilterCoefficientMaker<> cm;
+        cm.setSampleRateAndBlockSize(sampleRate, blockSize);
+        cm.MakeCoeffs(0.f, 0.7f, type, subtype, nullptr, false);
+
+        auto plain = sst::filters::QuadFilterUnitState{};
+        cm.updateState(plain);
+
+        arena.setFilterUnit(7, type, subtype);
+        cm.updateState(*arena.state(7));
+
+        for (auto f : testFreqs)
+            REQUIRE(runSine(*arena.state(7), fn, f, 512) == runSine(plain, fn, f, 512));
+
+        // and a reset clears just the live registers
+        auto sentinel = SIMD_MM(set1_ps)(1.f);
+        for (auto &r : arena.state(7)->R)
+            r = sentinel;
+        arena.reset(7);
+        for (int i = 0; i < sst::filters::n_filter_registers; ++i)
+        {
+            float r alignas(16)[4];
+            SIMD_MM(store_ps)(r, arena.state(7)->R[i]);
+            REQUIRE(r[0] == (i < arena.traits(7).registers ? 0.f : 1.f));
+        }
+    }
+}
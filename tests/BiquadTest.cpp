@@ -13,6 +13,7 @@
  * https://github.com/surge-synthesizer/sst-filters
  */
 #include "sst/filters/BiquadFilter.h"
+#include "sst/filters/EQChain.h"
 
 #include "TestUtils.h"
 
@@ -20,6 +21,21 @@ struct TP
 {
 };
 
+struct DBTP
+{
+    float db_to_linear(float x) { return std::pow(10.f, 0.05f * x); }
+};
+
+// Block i of a stereo test signal: a sine on the left and a sawtooth on the right
+static void fillTestBlock(int i, float *L, float *R)
+{
+    for (int j = 0; j < 32; ++j)
+    {
+        L[j] = std::sin((i * 32 + j) * 0.13f);
+        R[j] = ((i * 32 + j) % 17) / 8.5f - 1.f;
+    }
+}
+
 TEST_CASE("Simple Biquad")
 {
     using bqt = sst::filters::Biquad::BiquadFilter<TP, 32>;
@@ -53,3 +69,286 @@ TEST_CASE("Simple Biquad")
         }
     }
 }
+
+TEST_CASE("Biquad Block Matches Sample")
+{
+    using bqt = sst::filters::Biquad::BiquadFilter<TP, 32>;
+
+    TP tp;
+    bqt stereoBlock(&tp), monoBlock(&tp), sample(&tp);
+
+    float L alignas(16)[32], R alignas(16)[32], oL alignas(16)[32], oR alignas(16)[32];
+    float M alignas(16)[32];
+    for (int i = 0; i < 20; ++i)
+    {
+        // move the cutoff every block so the coefficient lags are running
+        for (auto *f : {&stereoBlock, &monoBlock, &sample})
+        {
+            f->coeff_LP(0.3 + i * 0.02, 0.9);
+            if (i == 0)
+                f->coeff_instantize();
+        }
+
+        fillTestBlock(i, L, R);
+
+        stereoBlock.process_block_to(L, R, oL, oR);
+        monoBlock.process_block_to(L, M);
+        for (int j = 0; j < 32; ++j)
+        {
+            float sL, sR;
+            sample.process_sample(L[j], R[j], sL, sR);
+            REQUIRE(oL[j] == Approx(sL).margin(1e-7));
+            REQUIRE(oR[j] == Approx(sR).margin(1e-7));
+            REQUIRE(M[j] == Approx(sL).margin(1e-7));
+        }
+    }
+}
+
+TEST_CASE("Float Precision Biquad")
+{
+    using adapter_t = sst::filters::Biquad::DefaultTuningAndDBAdapter<TP>;
+    using fbqt = sst::filters::Biquad::BiquadFilter<TP, 32, adapter_t, float>;
+    using dbqt = sst::filters::Biquad::BiquadFilter<TP, 32, adapter_t, double>;
+
+    TP tp;
+
+    SECTION("Block Matches Sample And Tracks Double")
+    {
+        fbqt block(&tp), sample(&tp);
+        dbqt reference(&tp);
+
+        float L alignas(16)[32], R alignas(16)[32], oL alignas(16)[32], oR alignas(16)[32];
+        float dL alignas(16)[32], dR alignas(16)[32];
+        for (int i = 0; i < 20; ++i)
+        {
+            block.coeff_orfanidisEQ(0.2 + i * 0.01, 1.0, 2.0, 1.41, 1.0);
+            sample.coeff_orfanidisEQ(0.2 + i * 0.01, 1.0, 2.0, 1.41, 1.0);
+            reference.coeff_orfanidisEQ(0.2 + i * 0.01, 1.0, 2.0, 1.41, 1.0);
+
+            fillTestBlock(i, L, R);
+
+            block.process_block_to(L, R, oL, oR);
+            reference.process_block_to(L, R, dL, dR);
+            for (int j = 0; j < 32; ++j)
+            {
+                float sL, sR;
+                sample.process_sample(L[j], R[j], sL, sR);
+                // not bit for bit, since process_sample may be contracted to FMAs
+                REQUIRE(oL[j] == Approx(sL).margin(1e-6));
+                REQUIRE(oR[j] == Approx(sR).margin(1e-6));
+                REQUIRE(oL[j] == Approx(dL[j]).margin(1e-3));
+                REQUIRE(oR[j] == Approx(dR[j]).margin(1e-3));
+            }
+        }
+    }
+
+    SECTION("Low Cutoffs Stay Stable")
+    {
+        fbqt bq(&tp);
+        // a pole this close to z = 1 rounds onto the unit circle in float without the clamp
+        bq.coeff_LP(1e-5, 20.0);
+        bq.coeff_instantize();
+
+        float x alignas(16)[32];
+        for (int i = 0; i < 2000; ++i)
+        {
+            for (int j = 0; j < 32; ++j)
+                x[j] = (i == 0 && j == 0) ? 1.f : 0.f;
+            bq.process_block(x);
+            for (int j = 0; j < 32; ++j)
+                REQUIRE(std::isfinite(x[j]));
+        }
+    }
+}
+
+TEST_CASE("EQ Chain")
+{
+    using bqt = sst::filters::Biquad::BiquadFilter<DBTP, 32>;
+    using eqt = sst::filters::Biquad::EQChain<DBTP, 32, 3>;
+
+    DBTP tp;
+    eqt eq(&tp);
+    bqt bands[3]{bqt(&tp), bqt(&tp), bqt(&tp)};
+
+    auto setBands = [&](int i) {
+        eq.coeff_lowShelf(0, 0.02 + i * 0.001, 0.707, 4.0);
+        bands[0].coeff_lowShelf(0.02 + i * 0.001, 0.707, 4.0);
+        eq.coeff_peakEQ(1, 0.3 - i * 0.005, 1.0, -6.0);
+        bands[1].coeff_peakEQ(0.3 - i * 0.005, 1.0, -6.0);
+        eq.design(2, [](auto &bq) { bq.coeff_HP(0.01, 0.707); });
+        bands[2].coeff_HP(0.01, 0.707);
+    };
+
+    float L alignas(16)[32], R alignas(16)[32], cL alignas(16)[32], cR alignas(16)[32];
+    auto fill = [&](int i) {
+        fillTestBlock(i, L, R);
+        for (int j = 0; j < 32; ++j)
+        {
+            cL[j] = L[j];
+            cR[j] = R[j];
+        }
+    };
+
+    SECTION("Matches Cascaded Biquads")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            setBands(i);
+            fill(i);
+            eq.process_block(L, R);
+            for (auto &b : bands)
+                b.process_block(cL, cR);
+            for (int j = 0; j < 32; ++j)
+            {
+                REQUIRE(L[j] == Approx(cL[j]).margin(1e-5));
+                REQUIRE(R[j] == Approx(cR[j]).margin(1e-5));
+            }
+        }
+
+        for (auto f : {0.001f, 0.01f, 0.1f, 0.3f})
+        {
+            auto expected = 1.f;
+            for (auto &b : bands)
+                expected *= b.plot_magnitude(f);
+            REQUIRE(eq.plot_magnitude(f) == Approx(expected).margin(1e-5));
+        }
+    }
+
+    SECTION("Shelf Gains")
+    {
+        bqt low(&tp), high(&tp);
+        low.coeff_lowShelf(0.1, 0.707, 6.0);
+        high.coeff_highShelf(0.1, 0.707, -6.0);
+        REQUIRE(low.plot_magnitude(0.0001) == Approx(std::pow(10.f, 0.3f)).margin(1e-3));
+        REQUIRE(low.plot_magnitude(0.45) == Approx(1.f).margin(1e-2));
+        REQUIRE(high.plot_magnitude(0.0001) == Approx(1.f).margin(1e-3));
+        REQUIRE(high.plot_magnitude(0.4999) == Approx(std::pow(10.f, -0.3f)).margin(1e-2));
+    }
+
+    SECTION("Bypass Skips The Band")
+    {
+        eq.setBypass(1, true);
+        REQUIRE(eq.isBypassed(1));
+        for (int i = 0; i < 20; ++i)
+        {
+            setBands(i);
+            fill(i);
+            eq.process_block(L, R);
+            bands[0].process_block(cL, cR);
+            bands[2].process_block(cL, cR);
+            for (int j = 0; j < 32; ++j)
+            {
+                REQUIRE(L[j] == Approx(cL[j]).margin(1e-5));
+                REQUIRE(R[j] == Approx(cR[j]).margin(1e-5));
+            }
+        }
+    }
+
+    SECTION("Undesigned Bands Pass Through")
+    {
+        sst::filters::Biquad::EQChain<DBTP, 32, 8> wide(&tp);
+
+        auto check = [&](auto &&design, auto &&reference) {
+            for (int i = 0; i < 20; ++i)
+            {
+                design(i);
+                fill(i);
+                wide.process_block(L, R);
+                reference(i);
+                for (int j = 0; j < 32; ++j)
+                {
+                    REQUIRE(L[j] == Approx(cL[j]).margin(1e-5));
+                    REQUIRE(R[j] == Approx(cR[j]).margin(1e-5));
+                }
+            }
+        };
+
+        // three of eight bands, not the first three
+        check(
+            [&](int i) {
+                wide.coeff_lowShelf(0, 0.02 + i * 0.001, 0.707, 4.0);
+                wide.coeff_peakEQ(4, 0.3 - i * 0.005, 1.0, -6.0);
+                wide.design(6, [](auto &bq) { bq.coeff_HP(0.01, 0.707); });
+                setBands(i);
+            },
+            [&](int) {
+                for (auto &b : bands)
+                    b.process_block(cL, cR);
+            });
+
+        // and after a suspend only the band designed again is in the chain
+        wide.suspend();
+        bands[1].suspend();
+        check(
+            [&](int i) {
+                wide.coeff_peakEQ(4, 0.3 - i * 0.005, 1.0, -6.0);
+                bands[1].coeff_peakEQ(0.3 - i * 0.005, 1.0, -6.0);
+            },
+            [&](int) { bands[1].process_block(cL, cR); });
+    }
+
+    SECTION("Mono")
+    {
+        for (int i = 0; i < 20; ++i)
+        {
+            setBands(i);
+            fill(i);
+            eq.process_block(L);
+            for (auto &b : bands)
+                b.process_block(cL);
+            for (int j = 0; j < 32; ++j)
+                REQUIRE(L[j] == Approx(cL[j]).margin(1e-5));
+        }
+    }
+}
+
+TEST_CASE("Biquad Magnitude Batch")
+{
+    using bqt = sst::filters::Biquad::BiquadFilter<DBTP, 32>;
+    using eqt = sst::filters::Biquad::EQChain<DBTP, 32, 4>;
+
+    DBTP tp;
+
+    // an odd count which is not a whole number of chunks
+    static constexpr int nf{151};
+    float freqs[nf], db[nf];
+    for (int i = 0; i < nf; ++i)
+        freqs[i] = 0.0005f * std::pow(980.f, i / (nf - 1.f));
+
+    SECTION("Single Biquads")
+    {
+        bqt lp(&tp), peak(&tp), shelf(&tp);
+        lp.coeff_LP(0.001, 4.0);
+        peak.coeff_peakEQ(0.2, 0.5, 9.0);
+        shelf.coeff_highShelf(0.05, 0.707, -12.0);
+
+        for (auto *bq : {&lp, &peak, &shelf})
+        {
+            bq->plot_magnitude_batch(freqs, db, nf);
+            for (int i = 0; i < nf; ++i)
+            {
+                INFO("f = " << freqs[i]);
+                auto expected = 20.f * std::log10(bq->plot_magnitude(freqs[i]));
+                REQUIRE(db[i] == Approx(expected).margin(1e-3));
+            }
+        }
+    }
+
+    SECTION("EQ Chain")
+    {
+        eqt eq(&tp);
+        eq.coeff_lowShelf(0, 0.01, 0.707, 6.0);
+        eq.coeff_peakEQ(1, 0.1, 1.0, -4.0);
+        eq.coeff_peakEQ(2, 0.3, 0.3, 3.0);
+        eq.coeff_highShelf(3, 0.4, 0.707, -6.0);
+        eq.setBypass(2, true);
+
+        eq.plot_magnitude_batch(freqs, db, nf);
+        for (int i = 0; i < nf; ++i)
+        {
+            INFO("f = " << freqs[i]);
+            auto expected = 20.f * std::log10(eq.plot_magnitude(freqs[i]));
+            REQUIRE(db[i] == Approx(expected).margin(1e-3));
+        }
+    }
+}
@@ -218,3 +218,110 @@ TEST_CASE("Cytomic SVF Quad Filter Test")
     runTest({FilterType::fut_cytomic_svf, FilterSubType::st_cytomic_allpass, ans[5]});
     runTest(sfpp::FilterModel::CytomicSVF, sfpp::Passband::Allpass, 0, 0.5, ans[5]);
 }
+
+TEST_CASE("Cytomic SVF Eight Channel")
+{
+    static constexpr int bs{16};
+    const float sri{1.f / 48000};
+    using Mode = sst::filters::CytomicSVF::Mode;
+
+    float in[8][bs], out[8][bs], ref[8][bs];
+    const float *inP[8];
+    float *outP[8];
+    for (int c = 0; c < 8; ++c)
+    {
+        inP[c] = in[c];
+        outP[c] = out[c];
+    }
+
+    auto fill = [&](int blk) {
+        for (int c = 0; c < 8; ++c)
+            for (int s = 0; s < bs; ++s)
+                in[c][s] = std::sin(0.013f * (c + 1) * (blk * bs + s)) + 0.1f * c;
+    };
+
+    for (auto nChannels : {8, 5})
+    {
+        DYNAMIC_SECTION("Smoothed SVFs match single SVFs with " << nChannels << " channels")
+        {
+            sst::filters::CytomicSVF8 svf8;
+            sst::filters::CytomicSVF single[8];
+            for (int blk = 0; blk < 20; ++blk)
+            {
+                fill(blk);
+                auto freq = 300.f + 150.f * blk;
+                svf8.setCoeffForBlock<bs>(Mode::Bell, freq, 0.6f, sri, 1.5f);
+                svf8.processBlock<bs>(inP, outP, nChannels);
+                for (int c = 0; c < nChannels; ++c)
+                {
+                    single[c].setCoeffForBlock<bs>(Mode::Bell, freq, 0.6f, sri, 1.5f);
+                    single[c].processBlock<bs>(in[c], ref[c]);
+                    for (int s = 0; s < bs; ++s)
+                        REQUIRE(out[c][s] == ref[c][s]);
+                }
+            }
+        }
+    }
+
+    SECTION("Bandpass bank matches two quad bandpasses")
+    {
+        sst::filters::CytomicSVF8 svf8;
+        sst::filters::CytomicSVF quads[2];
+        float freqs[8] = {100, 200, 400, 800, 1600, 3200, 6400, 12800};
+        for (int blk = 0; blk < 10; ++blk)
+        {
+            fill(blk);
+            for (auto &f : freqs)
+                f *= 1.02f;
+            svf8.setCoeffForBlockOctBandpass<bs>(freqs, 0.8f, sri);
+            svf8.processBlock<bs>(inP, outP);
+            for (int q = 0; q < 2; ++q)
+            {
+                quads[q].setCoeffForBlockQuadBandpass<bs>(freqs + 4 * q, 0.8f, sri);
+                for (int s = 0; s < bs; ++s)
+                {
+                    float v[4];
+                    for (int c = 0; c < 4; ++c)
+                        v[c] = in[4 * q + c][s];
+                    quads[q].processBlockStep(v[0], v[1], v[2], v[3]);
+                    for (int c = 0; c < 4; ++c)
+                        REQUIRE(out[4 * q + c][s] == v[c]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Cytomic SVF Per Lane Coefficients")
+{
+    static constexpr int bs{16};
+    const float sri{1.f / 48000};
+    using Mode = sst::filters::CytomicSVF::Mode;
+
+    std::array<Mode, 4> modes{Mode::Lowpass, Mode::Bell, Mode::Highpass, Mode::LowShelf};
+    float res[4] = {0.3f, 0.6f, 0.9f, 0.5f};
+    float amp[4] = {1.f, 2.f, 1.f, 0.5f};
+
+    sst::filters::CytomicSVF quad, single[4];
+    for (int blk = 0; blk < 40; ++blk)
+    {
+        float freq[4] = {200.f + 40.f * blk, 1000.f, 5000.f - 60.f * blk, 150.f + 5.f * blk};
+        quad.setCoeffForBlock<bs>(modes, freq, res, sri, amp);
+        for (int c = 0; c < 4; ++c)
+            single[c].setCoeffForBlock<bs>(modes[c], freq[c], res[c], sri, amp[c]);
+
+        for (int s = 0; s < bs; ++s)
+        {
+            float v[4], r[4];
+            for (int c = 0; c < 4; ++c)
+            {
+                v[c] = std::sin(0.02f * (c + 1) * (blk * bs + s));
+                r[c] = v[c];
+                single[c].processBlockStep(r[c]);
+            }
+            quad.processBlockStep(v[0], v[1], v[2], v[3]);
+            for (int c = 0; c < 4; ++c)
+                REQUIRE(v[c] == Approx(r[c]).margin(1e-4));
+        }
+    }
+}
@@ -13,6 +13,8 @@
  * https://github.com/surge-synthesizer/sst-filters
  */
 #include "sst/filters/HalfRateFilter.h"
+#include "sst/filters/CascadedOversampler.h"
+#include "sst/filters/HalfRateDesigner.h"
 #include "TestUtils.h"
 
 template <int BS = 32>
@@ -219,4 +221,305 @@ TEST_CASE("Half Rate a sample at a time")
             REQUIRE(Rdn == Approx(RdnBW[i]).margin(1e-6));
         }
     }
+
+    SECTION("Downsample Matches Block")
+    {
+        // Drive D2 directly at the higher rate rather than from U2. That round trip is almost
+        // band limited already so a single allpass branch would pass, but a stopband tone on L
+        // and noise on R need both branches to come out like process_block_D2.
+        sst::filters::HalfRate::HalfRateFilter hrfD(6, true);
+        sst::filters::HalfRate::HalfRateFilter hrfSD(6, true);
+
+        static constexpr size_t blockSize{8};
+        static constexpr size_t nPoints{256 * blockSize};
+        float Lhi alignas(16)[nPoints << 1], Rhi alignas(16)[nPoints << 1];
+        uint32_t seed{17};
+        for (int i = 0; i < (nPoints << 1); ++i)
+        {
+            seed = seed * 1664525 + 1013904223;
+            Lhi[i] = std::sin(0.4 * i * 2.0 * M_PI);
+            Rhi[i] = (seed >> 8) / (float)(1 << 23) - 1.f;
+        }
+
+        float LdnBW alignas(16)[nPoints], RdnBW alignas(16)[nPoints];
+        for (int i = 0; i < nPoints; i += blockSize)
+        {
+            hrfD.process_block_D2(&Lhi[2 * i], &Rhi[2 * i], 2 * blockSize, &LdnBW[i], &RdnBW[i]);
+        }
+
+        double stop{0};
+        for (int i = 0; i < nPoints; ++i)
+        {
+            float Ldn{0.f}, Rdn{0.f};
+            hrfSD.process_sample_D2(&Lhi[2 * i], &Rhi[2 * i], Ldn, Rdn);
+
+            INFO("Testing at " << i);
+            REQUIRE(Ldn == Approx(LdnBW[i]).margin(1e-6));
+            REQUIRE(Rdn == Approx(RdnBW[i]).margin(1e-6));
+            if (i > 256)
+                stop = std::max(stop, (double)std::fabs(Ldn));
+        }
+        REQUIRE(stop < 1e-3);
+    }
+}
+
+TEST_CASE("Quad Half Rate Filter")
+{
+    namespace hr = sst::filters::HalfRate;
+
+    auto gen = [](int ch, int i) {
+        auto f = 220.0 * (ch + 1) + 1000.0 * ch * ch;
+        return (float)std::sin(2.0 * M_PI * f * i / 48000.0);
+    };
+
+    for (int order = 1; order <= hr::halfrate_max_M; ++order)
+    {
+        for (const auto &steep : {true, false})
+        {
+            DYNAMIC_SECTION("Matches Stereo order=" << order << " steep=" << steep)
+            {
+                hr::HalfRateFilter upLo(order, steep), upHi(order, steep);
+                hr::HalfRateFilter dnLo(order, steep), dnHi(order, steep);
+                hr::QuadHalfRateFilter qUp(order, steep), qDn(order, steep);
+
+                REQUIRE(qUp.latency() == Approx(upLo.latency()));
+
+                for (int i = 0; i < 2048; ++i)
+                {
+                    float in alignas(16)[4];
+                    for (int ch = 0; ch < 4; ++ch)
+                        in[ch] = gen(ch, i);
+
+                    float up[4][2], dn[4];
+                    upLo.process_sample_U2(in[0], in[1], up[0], up[1]);
+                    upHi.process_sample_U2(in[2], in[3], up[2], up[3]);
+                    dnLo.process_sample_D2(up[0], up[1], dn[0], dn[1]);
+                    dnHi.process_sample_D2(up[2], up[3], dn[2], dn[3]);
+
+                    SIMD_M128 qup[2];
+                    qUp.process_sample_U2(SIMD_MM(load_ps)(in), qup);
+                    auto qdn = qDn.process_sample_D2(qup);
+
+                    float qu alignas(16)[2][4], qd alignas(16)[4];
+                    SIMD_MM(store_ps)(qu[0], qup[0]);
+                    SIMD_MM(store_ps)(qu[1], qup[1]);
+                    SIMD_MM(store_ps)(qd, qdn);
+
+                    INFO("Sample " << i);
+                    for (int ch = 0; ch < 4; ++ch)
+                    {
+                        REQUIRE(qu[0][ch] == up[ch][0]);
+                        REQUIRE(qu[1][ch] == up[ch][1]);
+                        REQUIRE(qd[ch] == Approx(dn[ch]).margin(1e-7));
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Blocks Match Samples")
+    {
+        static constexpr int blockSize{32};
+        hr::QuadHalfRateFilter bUp(6, true), bDn(6, true);
+        hr::QuadHalfRateFilter sUp(6, true), sDn(6, true);
+
+        for (int b = 0; b < 64; ++b)
+        {
+            SIMD_M128 in[blockSize], up[blockSize << 1], dn[blockSize];
+            for (int i = 0; i < blockSize; ++i)
+            {
+                auto s = b * blockSize + i;
+                in[i] = SIMD_MM(set_ps)(gen(3, s), gen(2, s), gen(1, s), gen(0, s));
+            }
+            bUp.process_block_U2(in, up, blockSize << 1);
+            bDn.process_block_D2(up, dn, blockSize << 1);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                SIMD_M128 sup[2];
+                sUp.process_sample_U2(in[i], sup);
+                auto sdn = sDn.process_sample_D2(sup);
+
+                float a alignas(16)[4], e alignas(16)[4];
+                SIMD_MM(store_ps)(a, dn[i]);
+                SIMD_MM(store_ps)(e, sdn);
+                for (int ch = 0; ch < 4; ++ch)
+                    REQUIRE(a[ch] == e[ch]);
+            }
+        }
+    }
+}
+
+template <int factor> void cascadeRoundTrip()
+{
+    static constexpr int blockSize{64};
+    sst::filters::HalfRate::CascadedOversampler<factor> os;
+
+    float L alignas(16)[blockSize], R alignas(16)[blockSize];
+    float Lu alignas(16)[blockSize * factor], Ru alignas(16)[blockSize * factor];
+    float Ld alignas(16)[blockSize], Rd alignas(16)[blockSize];
+
+    auto w = 2.0 * M_PI * 300.0 / 48000.0;
+    double sL{0}, cL{0}, sR{0}, cR{0};
+    static constexpr int nBlocks{150}, skip{75};
+    for (int b = 0; b < nBlocks; ++b)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            L[i] = std::sin(w * (b * blockSize + i));
+            R[i] = 0.5 * std::cos(w * (b * blockSize + i));
+        }
+        os.upsample(L, R, Lu, Ru, blockSize);
+        os.downsample(Lu, Ru, Ld, Rd, blockSize);
+
+        if (b >= skip)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                auto ph = w * (b * blockSize + i);
+                sL += Ld[i] * std::sin(ph);
+                cL += Ld[i] * std::cos(ph);
+                sR += Rd[i] * std::sin(ph);
+                cR += Rd[i] * std::cos(ph);
+            }
+        }
+    }
+    auto n = (nBlocks - skip) * blockSize;
+
+    INFO("Factor " << factor << " latency " << os.latency());
+    REQUIRE(2 * std::sqrt(sL * sL + cL * cL) / n == Approx(1.0).margin(1e-3));
+    REQUIRE(2 * std::sqrt(sR * sR + cR * cR) / n == Approx(0.5).margin(1e-3));
+    REQUIRE(std::atan2(-cL, sL) / w == Approx(os.latency()).margin(0.02));
+    // R is a cosine so is a quarter turn ahead
+    REQUIRE((std::atan2(-cR, sR) + M_PI / 2) / w == Approx(os.latency()).margin(0.02));
+}
+
+TEST_CASE("Cascaded Oversampler")
+{
+    namespace hr = sst::filters::HalfRate;
+
+    SECTION("Two Times Matches A Single Stage")
+    {
+        static constexpr int blockSize{32};
+        hr::CascadedOversampler<2> os;
+        auto st = hr::cascadeStageSettings(0);
+        hr::HalfRateFilter up(st.M, st.steep), dn(st.M, st.steep);
+
+        REQUIRE(os.latency() == up.latency());
+
+        for (int b = 0; b < 16; ++b)
+        {
+            float L alignas(16)[blockSize], R alignas(16)[blockSize];
+            for (int i = 0; i < blockSize; ++i)
+            {
+                L[i] = std::sin(0.03 * (b * blockSize + i));
+                R[i] = std::sin(0.7 * (b * blockSize + i));
+            }
+
+            float Lu alignas(16)[blockSize * 2], Ru alignas(16)[blockSize * 2];
+            float Le alignas(16)[blockSize * 2], Re alignas(16)[blockSize * 2];
+            os.upsample(L, R, Lu, Ru, blockSize);
+            up.process_block_U2_fullscale(L, R, Le, Re, blockSize * 2);
+            for (int i = 0; i < blockSize * 2; ++i)
+            {
+                REQUIRE(Lu[i] == Le[i]);
+                REQUIRE(Ru[i] == Re[i]);
+            }
+
+            float Ld alignas(16)[blockSize], Rd alignas(16)[blockSize];
+            os.downsample(Lu, Ru, Ld, Rd, blockSize);
+            dn.process_block_D2(Le, Re, blockSize * 2);
+            for (int i = 0; i < blockSize; ++i)
+            {
+                REQUIRE(Ld[i] == Le[i]);
+                REQUIRE(Rd[i] == Re[i]);
+            }
+        }
+    }
+
+    SECTION("Round Trips Are Unity Gain And Report Their Delay")
+    {
+        cascadeRoundTrip<2>();
+        cascadeRoundTrip<4>();
+        cascadeRoundTrip<8>();
+        cascadeRoundTrip<16>();
+    }
+}
+
+TEST_CASE("Half Rate Designer")
+{
+    namespace hr = sst::filters::HalfRate;
+    namespace hrd = sst::filters::HalfRate::HalfRateDesigner;
+
+    SECTION("Reproduces The Tables")
+    {
+        for (uint32_t M = 1; M <= hr::halfrate_max_M; ++M)
+        {
+            for (const auto &steep : {true, false})
+            {
+                // the transition bands noted in load_coefficients
+                float tb = steep ? (M == 1 ? 0.1f : (M == 2 ? 0.05f : 0.01f))
+                                 : (M <= 2 ? 0.1f : 0.05f);
+                INFO("M=" << M << " steep=" << steep);
+                float cA[hr::halfrate_max_M], cB[hr::halfrate_max_M];
+                hr::HalfRateFilter::get_coefficients(M, steep, cA, cB);
+
+                const auto &d = hrd::designForOrder(M, tb);
+                REQUIRE(d.M == M);
+                for (auto i = 0U; i < M; ++i)
+                {
+                    // the soft M=2 table has one entry which differs in the fifth place
+                    REQUIRE(d.cA[i] == Approx(cA[i]).margin(5e-5));
+                    REQUIRE(d.cB[i] == Approx(cB[i]).margin(5e-5));
+                }
+            }
+        }
+
+        REQUIRE(hrd::attenuationFor(6, 0.01f) == Approx(104).margin(1));
+        REQUIRE(hrd::attenuationFor(2, 0.1f) == Approx(70).margin(1));
+    }
+
+    SECTION("Spec Picks The Cheapest Design")
+    {
+        for (auto [atten, tb] : {std::make_pair(40.f, 0.1f), {60.f, 0.05f}, {90.f, 0.02f},
+                                 {100.f, 0.01f}, {140.f, 0.05f}})
+        {
+            INFO("Spec " << atten << "dB " << tb);
+            const auto &d = hrd::designForSpec(atten, tb);
+            REQUIRE(d.attenuation >= atten);
+            REQUIRE(d.attenuation == hrd::attenuationFor(d.M, tb));
+            if (d.M > 1)
+                REQUIRE(hrd::attenuationFor(d.M - 1, tb) < atten);
+            REQUIRE(&d == &hrd::designForSpec(atten, tb));
+        }
+
+        // an unreachable spec returns the largest design
+        const auto &d = hrd::designForSpec(300.f, 0.01f);
+        REQUIRE(d.M == hr::halfrate_max_M);
+        REQUIRE(d.attenuation < 300.f);
+    }
+
+    SECTION("Designs Meet Their Rejection")
+    {
+        for (auto [atten, tb] : {std::make_pair(40.f, 0.1f), {60.f, 0.05f}, {80.f, 0.04f}})
+        {
+            const auto &d = hrd::designForSpec(atten, tb);
+            // a tone just inside the stopband at the higher rate
+            auto w = 2.0 * M_PI * (0.25 + tb * 0.5 + 0.01);
+
+            hr::QuadHalfRateFilter dn(d.M, d.cA, d.cB);
+            double peak{0};
+            for (int i = 0; i < 8192; ++i)
+            {
+                SIMD_M128 in[2]{SIMD_MM(set1_ps)(std::sin(w * 2 * i)),
+                                SIMD_MM(set1_ps)(std::sin(w * (2 * i + 1)))};
+                auto o = SIMD_MM(cvtss_f32)(dn.process_sample_D2(in));
+                if (i > 4096)
+                    peak = std::max(peak, (double)std::fabs(o));
+            }
+            INFO("Spec " << atten << "dB " << tb << " design " << d.attenuation << "dB peak "
+                         << 20 * std::log10(peak));
+            REQUIRE(20 * std::log10(peak) < -d.attenuation + 1);
+        }
+    }
 }
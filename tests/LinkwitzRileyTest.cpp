@@ -33,9 +33,8 @@ struct Bands
  * for 50 ms then integrate over a whole number of cycles so the RMS of a pure
  * tone is exact, which keeps the reconstruction check tight.
  */
-Bands measure(float crossoverFreq, float toneFreq)
+template <typename Crossover> Bands measureWith(Crossover &lr, float crossoverFreq, float toneFreq)
 {
-    sst::filters::LinkwitzRileyLR4Crossover lr;
     lr.setCoeff(crossoverFreq, sri);
     lr.init();
 
@@ -63,6 +62,19 @@ Bands measure(float crossoverFreq, float toneFreq)
     return {std::sqrt(inSq / meas), std::sqrt(lowSq / meas), std::sqrt(highSq / meas),
             std::sqrt(sumSq / meas)};
 }
+
+Bands measure(float crossoverFreq, float toneFreq)
+{
+    sst::filters::LinkwitzRileyLR4Crossover lr;
+    return measureWith(lr, crossoverFreq, toneFreq);
+}
+
+Bands measureOrder(int order, float crossoverFreq, float toneFreq)
+{
+    sst::filters::LinkwitzRileyCrossover lr;
+    lr.setOrder(order);
+    return measureWith(lr, crossoverFreq, toneFreq);
+}
 } // namespace
 
 TEST_CASE("Linkwitz-Riley LR4 Crossover")
@@ -177,3 +189,180 @@ TEST_CASE("Linkwitz-Riley block processing matches per-sample stepping")
         }
     }
 }
+
+TEST_CASE("Linkwitz-Riley runtime order crossover")
+{
+    float xover = 1000.f;
+
+    SECTION("Every order sums flat and is -6 dB at the crossover")
+    {
+        for (auto order : {2, 4, 8})
+        {
+            for (auto tone : {100.f, 500.f, 1000.f, 2000.f, 8000.f})
+            {
+                auto b = measureOrder(order, xover, tone);
+                INFO("order " << order << " tone " << tone);
+                REQUIRE(b.sum / b.in == Approx(1.0).margin(0.01));
+            }
+            auto b = measureOrder(order, xover, xover);
+            INFO("order " << order);
+            REQUIRE(20 * std::log10(b.low / b.in) == Approx(-6.02).margin(0.1));
+            REQUIRE(20 * std::log10(b.high / b.in) == Approx(-6.02).margin(0.1));
+        }
+    }
+
+    SECTION("Higher orders are steeper")
+    {
+        auto lr2 = measureOrder(2, xover, 4 * xover);
+        auto lr4 = measureOrder(4, xover, 4 * xover);
+        auto lr8 = measureOrder(8, xover, 4 * xover);
+        // 12, 24 and 48 dB per octave, two octaves out
+        REQUIRE(20 * std::log10(lr2.low / lr2.in) == Approx(-24.6).margin(1.5));
+        REQUIRE(20 * std::log10(lr4.low / lr4.in) == Approx(-48.2).margin(1.5));
+        REQUIRE(20 * std::log10(lr8.low / lr8.in) < -90.0);
+    }
+
+    SECTION("LR4 matches the fixed LR4 crossover, gliding")
+    {
+        static constexpr int bs = 32;
+        sst::filters::LinkwitzRileyLR4Crossover fixed;
+        sst::filters::LinkwitzRileyCrossover runtime;
+        runtime.setOrder(4);
+        fixed.init();
+        runtime.init();
+
+        float inL[bs], inR[bs];
+        float fl[4][bs], rl[4][bs];
+        for (int blk = 0; blk < 16; ++blk)
+        {
+            for (int i = 0; i < bs; ++i)
+            {
+                auto t = (blk * bs + i) * sri;
+                inL[i] = (float)std::sin(2 * M_PI * 300.f * t);
+                inR[i] = (float)std::sin(2 * M_PI * 2500.f * t);
+            }
+
+            fixed.setCoeffForBlock<bs>(500.f + blk * 100.f, sri);
+            runtime.setCoeffForBlock<bs>(500.f + blk * 100.f, sri);
+            fixed.processBlock<bs>(inL, inR, fl[0], fl[1], fl[2], fl[3]);
+            runtime.processBlock<bs>(inL, inR, rl[0], rl[1], rl[2], rl[3]);
+            for (int c = 0; c < 4; ++c)
+                for (int i = 0; i < bs; ++i)
+                    REQUIRE(rl[c][i] == fl[c][i]);
+        }
+    }
+}
+
+TEST_CASE("Linkwitz-Riley multiband crossover")
+{
+    SECTION("Two bands are a plain LR4 split")
+    {
+        sst::filters::MultibandCrossover<2> mb;
+        sst::filters::LinkwitzRileyLR4Crossover lr;
+        float f = 800.f;
+        mb.setCoeff(&f, sri);
+        lr.setCoeff(f, sri);
+        mb.init();
+        lr.init();
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            float L = (float)std::sin(i * 0.03), R = (float)std::sin(i * 0.31);
+            float bl[2], br[2], lL, lR, hL, hR;
+            mb.step(L, R, bl, br);
+            lr.step(L, R, lL, lR, hL, hR);
+            REQUIRE(bl[0] == lL);
+            REQUIRE(br[0] == lR);
+            REQUIRE(bl[1] == hL);
+            REQUIRE(br[1] == hR);
+        }
+    }
+
+    SECTION("Five bands sum flat and each band owns its range")
+    {
+        static constexpr int nb = 5;
+        const float freqs[nb - 1] = {150.f, 600.f, 2400.f, 8000.f};
+        // a tone in the middle of each band
+        const float tones[nb] = {50.f, 300.f, 1200.f, 4400.f, 16000.f};
+
+        for (int tb = 0; tb < nb; ++tb)
+        {
+            sst::filters::MultibandCrossover<nb> mb;
+            mb.setCoeff(freqs, sri);
+            mb.init();
+
+            auto tone = tones[tb];
+            int warm = (int)(0.1 * sr);
+            int meas = (int)std::round(80 * sr / tone);
+            double inSq{0}, sumSq{0}, bandSq[nb]{};
+            for (int i = 0; i < warm + meas; ++i)
+            {
+                float s = (float)std::sin(2 * M_PI * tone * i * sri);
+                // the right channel is silent, so must stay so
+                float bl[nb], br[nb];
+                mb.step(s, 0.f, bl, br);
+
+                if (i >= warm)
+                {
+                    float sum{0};
+                    for (int b = 0; b < nb; ++b)
+                    {
+                        sum += bl[b];
+                        bandSq[b] += (double)bl[b] * bl[b];
+                        REQUIRE(br[b] == 0.f);
+                    }
+                    inSq += (double)s * s;
+                    sumSq += (double)sum * sum;
+                }
+            }
+
+            INFO("tone " << tone);
+            REQUIRE(std::sqrt(sumSq / inSq) == Approx(1.0).margin(0.01));
+            for (int b = 0; b < nb; ++b)
+                if (b != tb)
+                    REQUIRE(bandSq[b] < 0.25 * bandSq[tb]);
+        }
+    }
+
+    SECTION("Gliding block processing stays flat")
+    {
+        static constexpr int bs = 32;
+        static constexpr int nb = 4;
+        sst::filters::MultibandCrossover<nb> mb;
+        mb.init();
+
+        float inL[bs], inR[bs], outL[nb][bs], outR[nb][bs];
+        float *pl[nb], *pr[nb];
+        for (int b = 0; b < nb; ++b)
+        {
+            pl[b] = outL[b];
+            pr[b] = outR[b];
+        }
+
+        double inSq{0}, sumSq{0};
+        for (int blk = 0; blk < 200; ++blk)
+        {
+            const float freqs[nb - 1] = {200.f + blk, 1000.f + 5 * blk, 5000.f - 10 * blk};
+            mb.setCoeffForBlock<bs>(freqs, sri);
+            for (int i = 0; i < bs; ++i)
+            {
+                inL[i] = (float)std::sin(2 * M_PI * 700.f * (blk * bs + i) * sri);
+                inR[i] = inL[i];
+            }
+            mb.processBlock<bs>(inL, inR, pl, pr);
+
+            if (blk >= 20)
+            {
+                for (int i = 0; i < bs; ++i)
+                {
+                    float sum{0};
+                    for (int b = 0; b < nb; ++b)
+                        sum += outL[b][i];
+                    inSq += (double)inL[i] * inL[i];
+                    sumSq += (double)sum * sum;
+                }
+            }
+        }
+        REQUIRE(std::sqrt(sumSq / inSq) == Approx(1.0).margin(0.01));
+    }
+}
@@ -112,3 +112,55 @@ TEST_CASE("Tri-pole Filter")
                 {-30.506f, -22.8295f, -19.6699f, -18.9364f, -22.5596f});
     }
 }
+
+TEST_CASE("Tri-pole Filter Adaptive Solver")
+{
+    namespace tpf = sst::filters::TriPoleFilter;
+
+    auto makeState = [](float reso) {
+        auto state = sst::filters::QuadFilterUnitState{};
+        for (int i = 0; i < 4; ++i)
+            state.active[i] = (int)0xffffffff;
+
+        sst::filters::FilterCoefficientMaker<> cm;
+        cm.setSampleRateAndBlockSize(TestUtils::sampleRate, TestUtils::blockSize);
+        cm.MakeCoeffs(0, reso, sst::filters::fut_tripole, sst::filters::st_tripole_LLL3, nullptr,
+                      false);
+        cm.updateState(state);
+        return state;
+    };
+
+    SECTION("Matches The Fixed Solver")
+    {
+        for (auto reso : {0.f, 0.5f, 0.9f})
+        {
+            auto fixed = makeState(reso);
+            auto adapt = makeState(reso);
+            tpf::SolverStats stats;
+
+            float maxDiff{0};
+            for (int i = 0; i < TestUtils::blockSize; ++i)
+            {
+                auto x = SIMD_MM(set1_ps)((float)std::sin(2.0 * M_PI * i * 440.0 / 48000.0));
+                auto a = tpf::process<sst::filters::st_tripole_LLL3>(&fixed, x);
+                auto b = tpf::processAdaptive<sst::filters::st_tripole_LLL3>(&adapt, x, stats);
+                maxDiff = std::max(maxDiff, std::fabs(SIMD_MM(cvtss_f32)(SIMD_MM(sub_ps)(a, b))));
+            }
+            INFO("Resonance " << reso);
+            REQUIRE(maxDiff < 1e-3f);
+            REQUIRE(stats.samples == TestUtils::blockSize);
+            REQUIRE(stats.averageIterations() >= 1.f);
+            REQUIRE(stats.averageIterations() <= (float)tpf::nIterGlobal);
+        }
+    }
+
+    SECTION("Silence Converges In One Step")
+    {
+        auto state = makeState(0.5f);
+        tpf::SolverStats stats;
+        for (int i = 0; i < 64; ++i)
+            tpf::processAdaptive<sst::filters::st_tripole_LLL3>(&state, SIMD_MM(setzero_ps)(),
+                                                                stats);
+        REQUIRE(stats.averageIterations() == 1.f);
+    }
+}
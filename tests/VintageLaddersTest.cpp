@@ -56,3 +56,150 @@ TEST_CASE("Vintage Ladders")
                 {-6.17262f, -4.30116f, -3.1663f, -26.5073f, -53.0447f});
     }
 }
+
+TEST_CASE("Vintage Ladder Polyphase Decimator")
+{
+    namespace pd = sst::filters::PolyphaseDecimator;
+
+    auto runTone = [](auto decimator, double cyclesPerSubSample, float &dcGain) {
+        using dec_t = decltype(decimator);
+        static constexpr int factor = 4;
+        SIMD_M128 history[dec_t::historySize + 1]{};
+        SIMD_M128 in[factor];
+
+        for (int i = 0; i < 256; ++i)
+        {
+            for (int k = 0; k < factor; ++k)
+                in[k] = SIMD_MM(set1_ps)(1.f);
+            dcGain = SIMD_MM(cvtss_f32)(dec_t::process(in, history));
+        }
+
+        for (auto &h : history)
+            h = SIMD_MM(setzero_ps)();
+
+        double rms{0};
+        int pos{0};
+        for (int i = 0; i < 1024; ++i)
+        {
+            for (int k = 0; k < factor; ++k)
+                in[k] = SIMD_MM(set1_ps)((float)std::sin(2.0 * M_PI * cyclesPerSubSample * pos++));
+            auto v = SIMD_MM(cvtss_f32)(dec_t::process(in, history));
+            rms += v * v;
+        }
+        return std::sqrt(rms / 1024) / dcGain;
+    };
+
+    SECTION("DC Gain Matches The Legacy Reconstruction")
+    {
+        float dc4, dc8, dc12, dc16;
+        runTone(pd::Decimator<4, 4>(), 0.01, dc4);
+        runTone(pd::Decimator<4, 8>(), 0.01, dc8);
+        runTone(pd::Decimator<4, 12>(), 0.01, dc12);
+        runTone(pd::Decimator<4, 16>(), 0.01, dc16);
+        REQUIRE(dc4 == Approx(1.5f * (1.f + 0.57315917f - 0.0636844f)).margin(1e-5));
+        REQUIRE(dc8 == Approx(dc4).margin(1e-4));
+        REQUIRE(dc12 == Approx(dc4).margin(1e-4));
+        REQUIRE(dc16 == Approx(dc4).margin(1e-4));
+    }
+
+    SECTION("The Default RK Design Is Bit Identical To The Legacy Reconstruction")
+    {
+        uint32_t seed{23};
+        for (int i = 0; i < 1024; ++i)
+        {
+            SIMD_M128 in[4];
+            for (auto &v : in)
+            {
+                seed = seed * 1664525 + 1013904223;
+                v = SIMD_MM(set1_ps)((seed >> 8) / (float)(1 << 22) - 2.f);
+            }
+
+            // exactly the sum VintageLadder::RK::process used to return
+            auto ov = SIMD_MM(setzero_ps)();
+            const float w[4]{-0.0636844f, 0.f, 0.57315917f, 1.f};
+            for (int k = 0; k < 4; ++k)
+                ov = SIMD_MM(add_ps)(ov, SIMD_MM(mul_ps)(in[k], SIMD_MM(set1_ps)(w[k])));
+            ov = SIMD_MM(mul_ps)(SIMD_MM(set1_ps)(1.5f), ov);
+
+            REQUIRE(SIMD_MM(cvtss_f32)(pd::Decimator<4, 4>::process(in, nullptr)) ==
+                    SIMD_MM(cvtss_f32)(ov));
+        }
+    }
+
+    SECTION("More Taps Means Less Aliasing")
+    {
+        float dc;
+        // 0.3 cycles per sub-sample folds back into the output band
+        auto a4 = runTone(pd::Decimator<4, 4>(), 0.3, dc);
+        auto a8 = runTone(pd::Decimator<4, 8>(), 0.3, dc);
+        auto a16 = runTone(pd::Decimator<4, 16>(), 0.3, dc);
+        REQUIRE(a8 < a4);
+        REQUIRE(a16 < a8);
+        REQUIRE(a16 < 0.1);
+    }
+
+    SECTION("RK Runs With Each Tap Count")
+    {
+        for (auto fp : {sst::filters::VintageLadder::RK::process<4>,
+                        sst::filters::VintageLadder::RK::process<8>,
+                        sst::filters::VintageLadder::RK::process<12>,
+                        sst::filters::VintageLadder::RK::process<16>})
+        {
+            auto state = sst::filters::QuadFilterUnitState{};
+            sst::filters::FilterCoefficientMaker<> cm;
+            cm.setSampleRateAndBlockSize(TestUtils::sampleRate, TestUtils::blockSize);
+            cm.MakeCoeffs(0, 0.5, sst::filters::fut_vintageladder,
+                          sst::filters::st_vintage_type1, nullptr, false);
+            cm.updateState(state);
+
+            auto db = TestUtils::runSine(state, fp, 80.f, TestUtils::blockSize);
+            REQUIRE(std::isfinite(db));
+            // well below cutoff the reconstruction shouldn't change the level much
+            REQUIRE(db == Approx(-17.9486f).margin(1.0));
+        }
+    }
+
+    SECTION("Longer Decimators Keep Their History In The Counted Registers")
+    {
+        // The unit traits count the ladder registers plus the default decimator's history. A
+        // build which picks a longer decimator with SST_FILTERS_VINTAGE_LADDER_*_DECIMATOR_TAPS
+        // relies on the kernel keeping that history just past the ladder state and no further
+        namespace vl = sst::filters::VintageLadder;
+
+        auto check = [](sst::filters::FilterUnitQFPtr fp, sst::filters::FilterSubType st,
+                        int historyStart, int registers) {
+            auto state = sst::filters::QuadFilterUnitState{};
+            sst::filters::FilterCoefficientMaker<> cm;
+            cm.setSampleRateAndBlockSize(TestUtils::sampleRate, TestUtils::blockSize);
+            cm.MakeCoeffs(10.f, 0.5f, sst::filters::fut_vintageladder, st, nullptr, false);
+            cm.updateState(state);
+
+            for (int i = 0; i < 256; ++i)
+                fp(&state, SIMD_MM(set1_ps)(std::sin(i * 0.3f)));
+
+            auto isClear = [&state](int r) {
+                float v alignas(16)[4];
+                SIMD_MM(store_ps)(v, state.R[r]);
+                return v[0] == 0 && v[1] == 0 && v[2] == 0 && v[3] == 0;
+            };
+
+            bool anyHistory{false};
+            for (int r = historyStart; r < registers; ++r)
+                anyHistory = anyHistory || !isClear(r);
+            REQUIRE(anyHistory);
+
+            for (int r = registers; r < sst::filters::n_filter_registers; ++r)
+            {
+                INFO("Register " << r);
+                REQUIRE(isClear(r));
+            }
+        };
+
+        check(vl::RK::process<8>, sst::filters::st_vintage_type1, vl::RK::decimatorHistory,
+              vl::RK::decimatorHistory +
+                  sst::filters::PolyphaseDecimator::Decimator<4, 8>::historySize);
+        check(vl::Huov::process<4>, sst::filters::st_vintage_type2, vl::Huov::h_decimator,
+              vl::Huov::h_decimator +
+                  sst::filters::PolyphaseDecimator::Decimator<2, 4>::historySize);
+    }
+}
@@ -16,6 +16,10 @@
 #include "sst/filters++.h"
 #include "catch2/catch2.hpp"
 #include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <type_traits>
 
 TEST_CASE("Filters++ Ultra Basic")
 {
@@ -307,4 +311,941 @@ TEST_CASE("Configuration Selector")
             std::cout << sfpp::toString(l) << " " << v << std::endl;
         }
     }
-}
\ No newline at end of file
+
+    SECTION("Queries Are Compile Time")
+    {
+        using sfpp::FilterModel;
+        static_assert(sfpp::supportedValuesFor<sfpp::Slope>(FilterModel::OBXD_4Pole).size() == 5);
+        static_assert(sfpp::supportsChoice<sfpp::DriveMode>(FilterModel::CutoffWarp));
+        static_assert(!sfpp::supportsChoice<sfpp::Slope>(FilterModel::CutoffWarp));
+        static_assert(sfpp::isPartialConfigValid(FilterModel::CutoffWarp, sfpp::Passband::LP,
+                                                 sfpp::Slope::UNSUPPORTED,
+                                                 sfpp::DriveMode::OJD));
+        static_assert(
+            sfpp::partialConfigValues<sfpp::Slope>(FilterModel::VemberClassic, sfpp::Passband::LP)
+                .size() == 2);
+    }
+
+    SECTION("Allocation Free Queries Match A Brute Force Search")
+    {
+        for (auto fm : sfpp::Filter::availableModels())
+        {
+            INFO(sfpp::toString(fm));
+            auto cf = sfpp::Filter::availableModelConfigurations(fm);
+
+            std::set<sfpp::Passband> pbs;
+            for (auto &c : cf)
+                if (c.pt != sfpp::Passband::UNSUPPORTED)
+                    pbs.insert(c.pt);
+            auto pbv = sfpp::supportedValuesFor<sfpp::Passband>(fm);
+            REQUIRE(std::equal(pbs.begin(), pbs.end(), pbv.begin(), pbv.end()));
+
+            for (auto &c : cf)
+            {
+                REQUIRE(sfpp::isPartialConfigValid(fm, c.pt));
+                REQUIRE(sfpp::isPartialConfigValid(fm, c.pt, c.st));
+                REQUIRE(sfpp::isPartialConfigValid(fm, c.pt, c.st, c.dt));
+                REQUIRE(sfpp::closestValidModelTo(fm, c) == c);
+
+                // which drive modes go with this passband and slope, and is the list right
+                std::map<sfpp::DriveMode, bool> expected;
+                for (auto d : sfpp::supportedValuesFor<sfpp::DriveMode>(fm))
+                    expected[d] = false;
+                for (auto &o : cf)
+                    if (o.pt == c.pt && o.st == c.st)
+                        expected[o.dt] = true;
+
+                auto got = sfpp::partialConfigValuesAndValidity<sfpp::DriveMode>(fm, c.pt, c.st);
+                REQUIRE(got.size() == expected.size());
+                size_t i{0};
+                for (auto &[d, v] : expected)
+                {
+                    REQUIRE(got[i].first == d);
+                    REQUIRE(got[i].second == v);
+                    i++;
+                }
+
+                auto vec = sfpp::valuesAndValidityForPartialConfig<sfpp::DriveMode>(fm, c.pt, c.st);
+                REQUIRE(vec == got.toVector());
+            }
+        }
+    }
+}
+
+TEST_CASE("Filters++ Nonlinearity Quality")
+{
+    namespace sfpp = sst::filtersplusplus;
+    namespace sft = sst::filters;
+
+    SECTION("Tanh Tiers")
+    {
+        float maxCheap{0}, maxAccurate{0};
+        for (float x = -6.f; x <= 6.f; x += 0.01f)
+        {
+            auto v = SIMD_MM(set1_ps)(x);
+            auto c =
+                SIMD_MM(cvtss_f32)(sft::Nonlinearity::tanh<sft::NonlinearityAccuracy::Cheap>(v));
+            auto a =
+                SIMD_MM(cvtss_f32)(sft::Nonlinearity::tanh<sft::NonlinearityAccuracy::Accurate>(v));
+            maxCheap = std::max(maxCheap, std::fabs(c - std::tanh(x)));
+            maxAccurate = std::max(maxAccurate, std::fabs(a - std::tanh(x)));
+        }
+        REQUIRE(maxCheap < 0.03f);
+        REQUIRE(maxAccurate < 1e-6f);
+    }
+
+    SECTION("Quality Is Applied On Prepare")
+    {
+        auto run = [](sfpp::FilterModel m, sfpp::ModelConfig c, sfpp::NonlinearityQuality q) {
+            auto filter = sfpp::Filter();
+            filter.setSampleRateAndBlockSize(48000, 16);
+            filter.setFilterModel(m);
+            filter.setModelConfiguration(c);
+            filter.setNonlinearityQuality(q);
+            REQUIRE(filter.getNonlinearityQuality() == q);
+            REQUIRE(filter.prepareInstance());
+            REQUIRE(!filter.requiresPreparation());
+
+            double rms{0};
+            for (int i = 0; i < 4800; ++i)
+            {
+                if (i % 16 == 0)
+                {
+                    if (i != 0)
+                        filter.concludeBlock();
+                    filter.makeCoefficients(0, 0, 0.7);
+                    filter.prepareBlock();
+                }
+                auto x = 2.f * (float)std::sin(2.0 * M_PI * 220.0 * i / 48000.0);
+                auto y = filter.processMonoSample(x);
+                rms += y * y;
+            }
+            filter.concludeBlock();
+            return 10 * std::log10(rms / 4800);
+        };
+
+        for (auto [m, c] : {std::make_pair(sfpp::FilterModel::CutoffWarp,
+                                           sfpp::ModelConfig{sfpp::Passband::LP,
+                                                             sfpp::DriveMode::Tanh,
+                                                             sfpp::FilterSubModel::Warp_2Stage}),
+                            {sfpp::FilterModel::VintageLadder,
+                             sfpp::ModelConfig{sfpp::Passband::LP, sfpp::FilterSubModel::Huov}},
+                            {sfpp::FilterModel::TriPole,
+                             sfpp::ModelConfig{sfpp::Passband::LowLowLow,
+                                               sfpp::FilterSubModel::Third_output}}})
+        {
+            INFO(sfpp::Filter::getLegacyTypeFor(m, c)->first);
+            auto standard = run(m, c, sfpp::NonlinearityQuality::Standard);
+            auto cheap = run(m, c, sfpp::NonlinearityQuality::Cheap);
+            auto acc = run(m, c, sfpp::NonlinearityQuality::Accurate);
+            REQUIRE(std::isfinite(cheap));
+            REQUIRE(cheap == Approx(standard).margin(1.0));
+            REQUIRE(acc == Approx(standard).margin(0.5));
+        }
+
+        auto filter = sfpp::Filter();
+        filter.setFilterModel(sfpp::FilterModel::K35);
+        filter.setPassband(sfpp::Passband::LP);
+        filter.setDriveMode(sfpp::DriveMode::K35_Continuous);
+        REQUIRE(filter.prepareInstance());
+        filter.setNonlinearityQuality(sfpp::NonlinearityQuality::Accurate);
+        REQUIRE(filter.requiresPreparation());
+        REQUIRE(sfpp::toString(sfpp::NonlinearityQuality::Accurate) == "Accurate");
+    }
+}
+
+TEST_CASE("Filters++ Oversampled Filter")
+{
+    namespace sfpp = sst::filtersplusplus;
+
+    // through a Filter reference the model would run at the host rate
+    static_assert(!std::is_convertible_v<sfpp::OversampledFilter *, sfpp::Filter *>);
+
+    static constexpr int blockSize{16};
+
+    auto run = [](sfpp::OversampledFilter &filter, float cutoff, float reso,
+                  const std::function<float(int)> &gen, int n, std::vector<float> &out) {
+        out.resize(n);
+        for (int i = 0; i < n; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                if (i != 0)
+                    filter.concludeBlock();
+                for (int v = 0; v < 4; ++v)
+                    filter.makeCoefficients(v, cutoff, reso);
+                filter.prepareBlock();
+            }
+            out[i] = filter.processMonoSample(gen(i));
+        }
+        filter.concludeBlock();
+    };
+
+    // amplitude and delay in samples of a sine at w radians per sample, from n0 on
+    auto measure = [](const std::vector<float> &out, double w, int n0) {
+        double s{0}, c{0};
+        for (int i = n0; i < out.size(); ++i)
+        {
+            s += out[i] * std::sin(w * i);
+            c += out[i] * std::cos(w * i);
+        }
+        auto n = out.size() - n0;
+        return std::make_pair(2 * std::sqrt(s * s + c * c) / n, std::atan2(-c, s) / w);
+    };
+
+    SECTION("Resampling Alone Is Transparent And Reports Its Delay")
+    {
+        for (auto factor : {1, 2, 4, 8})
+        {
+            INFO("Oversampling " << factor);
+            auto filter = sfpp::OversampledFilter();
+            filter.setOversamplingFactor(factor);
+            filter.setSampleRateAndBlockSize(48000, blockSize);
+            REQUIRE(filter.getOversamplingFactor() == factor);
+            REQUIRE(filter.getBlockSize() == blockSize);
+            REQUIRE(filter.prepareInstance());
+
+            auto w = 2.0 * M_PI * 300.0 / 48000.0;
+            std::vector<float> out;
+            run(
+                filter, 0, 0, [w](int i) { return (float)std::sin(w * i); }, 9600, out);
+            auto [amp, delay] = measure(out, w, 4800);
+
+            REQUIRE(amp == Approx(1.0).margin(1e-3));
+            REQUIRE(delay == Approx(filter.getLatency()).margin(0.02));
+            if (factor == 1)
+                REQUIRE(filter.getLatency() == 0.f);
+            else
+                REQUIRE(filter.getLatency() > 0.f);
+        }
+    }
+
+    SECTION("Linear Model Matches The Base Rate Response")
+    {
+        auto response = [&](int factor) {
+            auto filter = sfpp::OversampledFilter();
+            filter.setOversamplingFactor(factor);
+            filter.setSampleRateAndBlockSize(48000, blockSize);
+            filter.setFilterModel(sfpp::FilterModel::VemberClassic);
+            filter.setPassband(sfpp::Passband::LP);
+            filter.setSlope(sfpp::Slope::Slope_12dB);
+            filter.setDriveMode(sfpp::DriveMode::Standard);
+            REQUIRE(filter.prepareInstance());
+
+            auto w = 2.0 * M_PI * 880.0 / 48000.0;
+            std::vector<float> out;
+            run(
+                filter, 0, 0.3, [w](int i) { return (float)std::sin(w * i); }, 9600, out);
+            return 20 * std::log10(measure(out, w, 4800).first);
+        };
+
+        auto base = response(1);
+        REQUIRE(response(2) == Approx(base).margin(0.25));
+        REQUIRE(response(4) == Approx(base).margin(0.25));
+    }
+
+    SECTION("Oversampling Reduces Aliasing From A Nonlinear Model")
+    {
+        // a driven tanh stage with a 5k input puts its 7th harmonic at 35k, which aliases to 13k
+        auto aliasLevel = [&](int factor) {
+            auto filter = sfpp::OversampledFilter();
+            filter.setOversamplingFactor(factor);
+            filter.setSampleRateAndBlockSize(48000, blockSize);
+            filter.setFilterModel(sfpp::FilterModel::CutoffWarp);
+            filter.setModelConfiguration({sfpp::Passband::LP, sfpp::DriveMode::Tanh,
+                                          sfpp::FilterSubModel::Warp_1Stage});
+            REQUIRE(filter.prepareInstance());
+
+            auto w = 2.0 * M_PI * 5000.0 / 48000.0;
+            std::vector<float> out;
+            run(
+                filter, 40, 0.9, [w](int i) { return 8.f * (float)std::sin(w * i); }, 9600, out);
+            return 20 * std::log10(measure(out, 2.0 * M_PI * 13000.0 / 48000.0, 4800).first);
+        };
+
+        auto base = aliasLevel(1);
+        auto os = aliasLevel(4);
+        INFO("Alias at 1x " << base << " dB and 4x " << os << " dB");
+        REQUIRE(os < base - 20);
+    }
+
+    SECTION("A Change Without A Fade Restarts The Resampling")
+    {
+        auto gen = [](int i) { return (float)std::sin(0.1 * i); };
+        auto switched = [&](bool crossfade) {
+            auto filter = sfpp::OversampledFilter();
+            filter.setOversamplingFactor(4);
+            filter.setSampleRateAndBlockSize(48000, blockSize);
+            filter.setFilterModel(sfpp::FilterModel::VemberClassic);
+            filter.setModelConfiguration(
+                {sfpp::Passband::LP, sfpp::Slope::Slope_12dB, sfpp::DriveMode::Standard});
+            REQUIRE(filter.prepareInstance());
+
+            std::vector<float> out;
+            run(filter, 0, 0.3, gen, 1600, out);
+
+            // with no crossfade state provided the change is immediate
+            filter.setFilterModel(sfpp::FilterModel::CytomicSVF);
+            filter.setModelConfiguration({sfpp::Passband::HP});
+            if (crossfade)
+                REQUIRE(filter.prepareInstanceWithCrossfade(64));
+            else
+                REQUIRE(filter.prepareInstance());
+            REQUIRE(!filter.isCrossfading());
+
+            run(filter, 0, 0.3, gen, 160, out);
+            return out;
+        };
+
+        REQUIRE(switched(true) == switched(false));
+    }
+}
+
+TEST_CASE("Filters++ Process Block")
+{
+    namespace sfpp = sst::filtersplusplus;
+
+    static constexpr int blockSize{16};
+    static constexpr int nSamples{blockSize * 40};
+
+    auto configure = [](auto &filter) {
+        filter.setSampleRateAndBlockSize(48000, blockSize);
+        filter.setFilterModel(sfpp::FilterModel::VemberClassic);
+        filter.setPassband(sfpp::Passband::LP);
+        filter.setSlope(sfpp::Slope::Slope_24dB);
+        filter.setDriveMode(sfpp::DriveMode::Standard);
+        for (int v = 0; v < 4; ++v)
+            filter.setActive(v, true);
+        REQUIRE(filter.prepareInstance());
+    };
+
+    auto input = [](int c, int i) { return (float)std::sin(0.013 * (c + 1) * i + c); };
+
+    // The classic loop, remaking the same coefficients every block
+    std::vector<float> reference[4];
+    {
+        auto filter = sfpp::Filter();
+        configure(filter);
+        for (auto &r : reference)
+            r.resize(nSamples);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                if (i != 0)
+                    filter.concludeBlock();
+                for (int v = 0; v < 4; ++v)
+                    filter.makeCoefficients(v, -12 + 6 * v, 0.6);
+                filter.prepareBlock();
+            }
+            float in alignas(16)[4], out alignas(16)[4];
+            for (int c = 0; c < 4; ++c)
+                in[c] = input(c, i);
+            filter.processQuadSample(in, out);
+            for (int c = 0; c < 4; ++c)
+                reference[c][i] = out[c];
+        }
+        filter.concludeBlock();
+    }
+
+    SECTION("Planar Blocks Of Any Size Match The Classic Loop")
+    {
+        for (auto hostSize : {1, 7, 13, 16, 100})
+        {
+            INFO("Host block size " << hostSize);
+            auto filter = sfpp::Filter();
+            configure(filter);
+            for (int v = 0; v < 4; ++v)
+                filter.makeCoefficients(v, -12 + 6 * v, 0.6);
+
+            std::vector<float> inB[4], outB[4];
+            for (int c = 0; c < 4; ++c)
+            {
+                inB[c].resize(nSamples);
+                outB[c].resize(nSamples);
+                for (int i = 0; i < nSamples; ++i)
+                    inB[c][i] = input(c, i);
+            }
+
+            for (int pos = 0; pos < nSamples; pos += hostSize)
+            {
+                auto n = std::min(hostSize, nSamples - pos);
+                const float *ip[4];
+                float *op[4];
+                for (int c = 0; c < 4; ++c)
+                {
+                    ip[c] = inB[c].data() + pos;
+                    op[c] = outB[c].data() + pos;
+                }
+                filter.processBlock(ip, op, 4, n);
+            }
+
+            for (int c = 0; c < 4; ++c)
+                for (int i = 0; i < nSamples; ++i)
+                    REQUIRE(outB[c][i] == reference[c][i]);
+        }
+    }
+
+    SECTION("Sample Accurate Events")
+    {
+        struct InspectableFilter : sfpp::Filter
+        {
+            using sfpp::Filter::payload;
+        };
+
+        std::vector<float> inB[4], outB[4];
+        const float *ip[4];
+        float *op[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            inB[c].resize(nSamples);
+            outB[c].resize(nSamples);
+            for (int i = 0; i < nSamples; ++i)
+                inB[c][i] = input(c, i);
+            ip[c] = inB[c].data();
+            op[c] = outB[c].data();
+        }
+
+        auto filter = InspectableFilter();
+        configure(filter);
+        for (int v = 0; v < 4; ++v)
+            filter.makeCoefficients(v, -12 + 6 * v, 0.6);
+
+        // voice 1 moves mid block, voice 3 on a block boundary
+        static constexpr int midOffset{5 * blockSize + 5}, boundaryOffset{10 * blockSize};
+        std::array<sfpp::FilterEvent, 2> events{
+            {{1, midOffset, 18.f, 0.2f}, {3, boundaryOffset, -30.f, 0.9f}}};
+
+        // stop at the end of the block with the mid block event to see where its ramp got to
+        filter.processBlock(ip, op, 4, 6 * blockSize, events);
+        for (int i = 0; i < sst::filters::n_cm_coeffs; ++i)
+            REQUIRE(filter.payload.makers[1].C[i] ==
+                    Approx(filter.payload.makers[1].tC[i]).margin(1e-5));
+
+        const float *ip2[4];
+        float *op2[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            ip2[c] = ip[c] + 6 * blockSize;
+            op2[c] = op[c] + 6 * blockSize;
+        }
+        std::array<sfpp::FilterEvent, 1> shifted{events[1]};
+        shifted[0].sampleOffset -= 6 * blockSize;
+        filter.processBlock(ip2, op2, 4, nSamples - 6 * blockSize, shifted);
+
+        for (int i = 0; i < nSamples; ++i)
+        {
+            INFO("Sample " << i);
+            REQUIRE(outB[0][i] == reference[0][i]);
+            REQUIRE(outB[2][i] == reference[2][i]);
+            if (i < midOffset)
+                REQUIRE(outB[1][i] == reference[1][i]);
+            if (i < boundaryOffset)
+                REQUIRE(outB[3][i] == reference[3][i]);
+        }
+        REQUIRE(outB[1][midOffset + 20] != reference[1][midOffset + 20]);
+
+        // and the boundary event is exactly a makeCoefficients call for that block
+        auto classic = sfpp::Filter();
+        configure(classic);
+        for (int i = 0; i < nSamples; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                if (i != 0)
+                    classic.concludeBlock();
+                if (i < boundaryOffset)
+                    classic.makeCoefficients(3, -12 + 18, 0.6);
+                else
+                    classic.makeCoefficients(3, -30, 0.9);
+                classic.prepareBlock();
+            }
+            float in alignas(16)[4]{}, out alignas(16)[4];
+            in[3] = input(3, i);
+            classic.processQuadSample(in, out);
+            REQUIRE(out[3] == outB[3][i]);
+        }
+    }
+
+    SECTION("Interleaved Matches Planar")
+    {
+        static constexpr int nCh{3};
+        auto planar = sfpp::Filter(), interleaved = sfpp::Filter();
+        configure(planar);
+        configure(interleaved);
+        for (int v = 0; v < 4; ++v)
+        {
+            planar.makeCoefficients(v, -12 + 6 * v, 0.6);
+            interleaved.makeCoefficients(v, -12 + 6 * v, 0.6);
+        }
+
+        std::vector<float> inP[nCh], outP[nCh], inI(nSamples * nCh), outI(nSamples * nCh);
+        for (int c = 0; c < nCh; ++c)
+        {
+            inP[c].resize(nSamples);
+            outP[c].resize(nSamples);
+            for (int i = 0; i < nSamples; ++i)
+            {
+                inP[c][i] = input(c, i);
+                inI[i * nCh + c] = input(c, i);
+            }
+        }
+        const float *ip[nCh];
+        float *op[nCh];
+        for (int c = 0; c < nCh; ++c)
+        {
+            ip[c] = inP[c].data();
+            op[c] = outP[c].data();
+        }
+        planar.processBlock(ip, op, nCh, nSamples);
+        interleaved.processInterleavedBlock(inI.data(), outI.data(), nCh, nSamples);
+
+        for (int c = 0; c < nCh; ++c)
+            for (int i = 0; i < nSamples; ++i)
+                REQUIRE(outI[i * nCh + c] == outP[c][i]);
+    }
+
+    SECTION("Oversampled Filter Blocks Match Its Sample Loop")
+    {
+        auto blocked = sfpp::OversampledFilter(), looped = sfpp::OversampledFilter();
+        for (auto *f : {&blocked, &looped})
+        {
+            f->setOversamplingFactor(2);
+            configure(*f);
+        }
+
+        std::vector<float> inB(nSamples), outB(nSamples), outL(nSamples);
+        for (int i = 0; i < nSamples; ++i)
+            inB[i] = input(0, i);
+
+        for (int i = 0; i < nSamples; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                if (i != 0)
+                    looped.concludeBlock();
+                looped.makeCoefficients(0, 0, 0.6);
+                looped.prepareBlock();
+            }
+            outL[i] = looped.processMonoSample(inB[i]);
+        }
+
+        blocked.makeCoefficients(0, 0, 0.6);
+        for (int pos = 0; pos < nSamples; pos += 11)
+        {
+            auto n = std::min(11, nSamples - pos);
+            const float *ip = inB.data() + pos;
+            float *op = outB.data() + pos;
+            blocked.processBlock(&ip, &op, 1, n);
+        }
+
+        for (int i = 0; i < nSamples; ++i)
+            REQUIRE(outB[i] == Approx(outL[i]).margin(1e-6));
+    }
+}
+
+TEST_CASE("Filters++ Static Filter")
+{
+    namespace sfpp = sst::filtersplusplus;
+
+    static constexpr int blockSize{16};
+
+    auto compare = [](auto &&staticFilter, sfpp::FilterModel model, const sfpp::ModelConfig &mc,
+                      float extra) {
+        INFO(mc.toString());
+        auto filter = sfpp::Filter();
+        filter.setSampleRateAndBlockSize(48000, blockSize);
+        filter.setFilterModel(model);
+        filter.setModelConfiguration(mc);
+        REQUIRE(filter.prepareInstance());
+        REQUIRE(filter.displayName() == staticFilter.displayName());
+
+        staticFilter.setSampleRateAndBlockSize(48000, blockSize);
+
+        for (int i = 0; i < blockSize * 50; ++i)
+        {
+            if (i % blockSize == 0)
+            {
+                if (i != 0)
+                {
+                    filter.concludeBlock();
+                    staticFilter.concludeBlock();
+                }
+                for (int v = 0; v < 4; ++v)
+                {
+                    auto cutoff = -20.f + 10 * v + 5 * std::sin(i * 0.01f);
+                    filter.makeCoefficients(v, cutoff, 0.7, extra);
+                    staticFilter.makeCoefficients(v, cutoff, 0.7, extra);
+                }
+                filter.prepareBlock();
+                staticFilter.prepareBlock();
+            }
+            auto in = SIMD_MM(set_ps)(std::sin(i * 0.03f), std::sin(i * 0.07f),
+                                      std::sin(i * 0.011f), std::sin(i * 0.2f));
+            float a alignas(16)[4], b alignas(16)[4];
+            SIMD_MM(store_ps)(a, filter.processSample(in));
+            SIMD_MM(store_ps)(b, staticFilter.processSample(in));
+            for (int v = 0; v < 4; ++v)
+                REQUIRE(a[v] == b[v]);
+        }
+    };
+
+    SECTION("Vember Classic")
+    {
+        compare(sfpp::StaticFilter<sfpp::FilterModel::VemberClassic, sfpp::Passband::LP,
+                                   sfpp::Slope::Slope_24dB, sfpp::DriveMode::Standard>(),
+                sfpp::FilterModel::VemberClassic,
+                {sfpp::Passband::LP, sfpp::Slope::Slope_24dB, sfpp::DriveMode::Standard}, 0.f);
+    }
+
+    SECTION("K35")
+    {
+        compare(sfpp::StaticFilter<sfpp::FilterModel::K35, sfpp::Passband::HP,
+                                   sfpp::Slope::UNSUPPORTED, sfpp::DriveMode::K35_Mild>(),
+                sfpp::FilterModel::K35, {sfpp::Passband::HP, sfpp::DriveMode::K35_Mild}, 0.f);
+    }
+
+    SECTION("Cutoff Warp")
+    {
+        compare(sfpp::StaticFilter<sfpp::FilterModel::CutoffWarp, sfpp::Passband::BP,
+                                   sfpp::Slope::UNSUPPORTED, sfpp::DriveMode::OJD,
+                                   sfpp::FilterSubModel::Warp_3Stage>(),
+                sfpp::FilterModel::CutoffWarp,
+                {sfpp::Passband::BP, sfpp::DriveMode::OJD, sfpp::FilterSubModel::Warp_3Stage},
+                0.f);
+    }
+
+    SECTION("Cytomic Bell")
+    {
+        compare(sfpp::StaticFilter<sfpp::FilterModel::CytomicSVF, sfpp::Passband::Bell>(),
+                sfpp::FilterModel::CytomicSVF, {sfpp::Passband::Bell}, 0.5f);
+    }
+
+    SECTION("Carries A Single Unit State")
+    {
+        // one unit state and the four voices' coefficient makers, with no room for a second
+        // state such as a crossfade's
+        using sf_t = sfpp::StaticFilter<sfpp::FilterModel::CytomicSVF, sfpp::Passband::HP>;
+        static_assert(sizeof(sf_t) < 2 * sizeof(sst::filters::QuadFilterUnitState) +
+                                         4 * sizeof(sst::filters::FilterCoefficientMaker<>));
+        REQUIRE(true);
+    }
+
+    SECTION("Legacy Types Resolve At Compile Time")
+    {
+        static_assert(sfpp::Filter::getLegacyTypeFor(
+                          sfpp::FilterModel::DiodeLadder,
+                          {sfpp::Passband::LP, sfpp::Slope::Slope_18dB})
+                          ->second == sst::filters::FilterSubType::st_diode_18dB);
+        static_assert(!sfpp::Filter::getLegacyTypeFor(sfpp::FilterModel::DiodeLadder,
+                                                      {sfpp::Passband::HP})
+                           .has_value());
+        REQUIRE(true);
+    }
+}
+
+TEST_CASE("Filters++ Model Registry")
+{
+    namespace sfpp = sst::filtersplusplus;
+
+    for (auto m : sfpp::Filter::availableModels())
+    {
+        INFO(sfpp::toString(m));
+        auto table = sfpp::details::FilterPayload::configurationTable(m);
+        auto configs = sfpp::Filter::modelConfigurations(m);
+        REQUIRE(table.size() == configs.size());
+        if (m != sfpp::FilterModel::None)
+            REQUIRE(!configs.empty());
+
+        // strictly sorted, so every configuration is unique and found by binary search
+        for (size_t i = 1; i < configs.size(); ++i)
+            REQUIRE(configs[i - 1] < configs[i]);
+
+        auto vec = sfpp::Filter::availableModelConfigurations(m);
+        REQUIRE(vec.size() == configs.size());
+        for (size_t i = 0; i < configs.size(); ++i)
+        {
+            REQUIRE(vec[i] == configs[i]);
+            REQUIRE(table[i].first == configs[i]);
+
+            auto lt = sfpp::Filter::getLegacyTypeFor(m, configs[i]);
+            REQUIRE(lt.has_value());
+            REQUIRE(*lt == table[i].second);
+        }
+    }
+}
+
+TEST_CASE("Filters++ Filter Unit Traits")
+{
+    namespace sfpp = sst::filtersplusplus;
+    namespace sft = sst::filters;
+
+    SECTION("Traits Are Known At Compile Time")
+    {
+        using sfpp::DriveMode;
+        using sfpp::FilterModel;
+        using sfpp::Passband;
+        using sfpp::Slope;
+
+        static constexpr auto cyt = sfpp::Filter::getFilterUnitTraitsFor(
+            FilterModel::CytomicSVF, {Passband::LP});
+        static_assert(cyt.has_value() && cyt->registers == 2 && !cyt->nonlinear);
+        static_assert(cyt->cost == sft::FilterUnitCost::Light);
+
+        static_assert(!sfpp::Filter::getFilterUnitTraitsFor(FilterModel::VemberClassic,
+                                                            {Passband::UNSUPPORTED})
+                           .has_value());
+
+        static_assert(sfpp::StaticFilter<FilterModel::CytomicSVF, Passband::HP>::traits
+                          .coefficients == 6);
+    }
+
+    SECTION("Unused State Is Never Touched")
+    {
+        // Poison everything a unit claims not to use with NaN; if the claim is wrong the NaN
+        // reaches the output or the register is overwritten.
+        struct PoisonableFilter : sfpp::Filter
+        {
+            using sfpp::Filter::payload;
+        };
+
+        auto nan = SIMD_MM(set1_ps)(std::numeric_limits<float>::quiet_NaN());
+        auto poisonCoefficients = [nan](PoisonableFilter &f) {
+            auto &tr = f.getFilterUnitTraits();
+            for (int i = tr.coefficients; i < sft::n_cm_coeffs; ++i)
+            {
+                f.payload.qfuState.C[i] = nan;
+                f.payload.qfuState.dC[i] = nan;
+            }
+        };
+        auto unusedRegistersArePoisoned = [](PoisonableFilter &f) {
+            auto &tr = f.getFilterUnitTraits();
+            for (int i = tr.registers; i < sft::n_filter_registers; ++i)
+            {
+                float r alignas(16)[4];
+                SIMD_MM(store_ps)(r, f.payload.qfuState.R[i]);
+                for (int v = 0; v < 4; ++v)
+                    if (!std::isnan(r[v]))
+                        return false;
+            }
+            return true;
+        };
+
+        for (auto m : sfpp::Filter::availableModels())
+        {
+            if (m == sfpp::FilterModel::None)
+                continue;
+
+            for (auto c : sfpp::Filter::modelConfigurations(m))
+            {
+                INFO(sfpp::toString(m) << " " << c.toString());
+                auto traits = sfpp::Filter::getFilterUnitTraitsFor(m, c);
+                REQUIRE(traits.has_value());
+                REQUIRE(traits->registers <= sft::n_filter_registers);
+                REQUIRE(traits->coefficients <= sft::n_cm_coeffs);
+
+                auto dlSize = sfpp::Filter::requiredDelayLinesSizes(m, c);
+                REQUIRE(dlSize == traits->delayLineSize);
+                std::vector<float> dlClean(dlSize * 4), dlPoison(dlSize * 4);
+
+                PoisonableFilter clean, poison;
+                for (auto *f : {&clean, &poison})
+                {
+                    f->setFilterModel(m);
+                    f->setModelConfiguration(c);
+                    f->setSampleRateAndBlockSize(48000, 16);
+                    f->setQuad();
+                }
+                if (dlSize > 0)
+                {
+                    clean.provideAllDelayLines(dlClean.data());
+                    poison.provideAllDelayLines(dlPoison.data());
+                }
+                REQUIRE(clean.prepareInstance());
+                REQUIRE(poison.prepareInstance());
+                REQUIRE(poison.getFilterUnitTraits().registers == traits->registers);
+
+                for (int i = traits->registers; i < sft::n_filter_registers; ++i)
+                    poison.payload.qfuState.R[i] = nan;
+
+                auto extras = sfpp::Filter::coefficientsExtraCount(m, c);
+                auto run = [&](int blocks) {
+                    double ph{0};
+                    for (int b = 0; b < blocks; ++b)
+                    {
+                        for (auto *f : {&clean, &poison})
+                        {
+                            for (int v = 0; v < 4; ++v)
+                                f->makeCoefficients(v, -12 + 6 * v, 0.3f + 0.1f * v,
+                                                    extras > 0 ? 0.4f : 0.f);
+                            f->prepareBlock();
+                        }
+                        poisonCoefficients(poison);
+
+                        for (int s = 0; s < 16; ++s)
+                        {
+                            auto in = SIMD_MM(set1_ps)(0.7f * std::sin(ph));
+                            ph += 2.0 * M_PI * 220.0 / 48000.0;
+                            auto oc = clean.processSample(in);
+                            auto op = poison.processSample(in);
+                            REQUIRE(memcmp(&oc, &op, sizeof(SIMD_M128)) == 0);
+                        }
+                        clean.concludeBlock();
+                        poison.concludeBlock();
+                    }
+                };
+
+                run(20);
+                REQUIRE(unusedRegistersArePoisoned(poison));
+
+                // and reset and resetVoice leave them be, while still clearing the live ones
+                clean.reset();
+                poison.reset();
+                REQUIRE(unusedRegistersArePoisoned(poison));
+                run(4);
+                clean.resetVoice(2);
+                poison.resetVoice(2);
+                REQUIRE(unusedRegistersArePoisoned(poison));
+                run(4);
+            }
+        }
+    }
+}
+
+TEST_CASE("Filters++ Model Crossfade")
+{
+    namespace sfpp = sst::filtersplusplus;
+
+    sfpp::Filter::CrossfadeState xf;
+    auto configure = [&xf](sfpp::Filter &f, sfpp::FilterModel m, const sfpp::ModelConfig &c) {
+        f.provideCrossfadeState(&xf);
+        f.setFilterModel(m);
+        f.setModelConfiguration(c);
+        f.setSampleRateAndBlockSize(48000, 16);
+        f.setStereo();
+    };
+
+    auto runBlock = [](sfpp::Filter &f, float *out, int &t) {
+        for (int v = 0; v < 2; ++v)
+            f.makeCoefficients(v, -6.f, 0.5f);
+        f.prepareBlock();
+        for (int s = 0; s < 16; ++s)
+        {
+            auto x = (float)std::sin(2.0 * M_PI * 330.0 * t / 48000.0);
+            t++;
+            out[s] = SIMD_MM(cvtss_f32)(f.processSample(SIMD_MM(set1_ps)(x)));
+        }
+        f.concludeBlock();
+    };
+
+    SECTION("Fades From The Old Model To The New One")
+    {
+        auto filter = sfpp::Filter();
+        configure(filter, sfpp::FilterModel::VemberClassic,
+                  {sfpp::Passband::LP, sfpp::Slope::Slope_12dB, sfpp::DriveMode::Standard});
+        REQUIRE(filter.prepareInstance());
+
+        int t{0};
+        float out[16], ref[16];
+        for (int b = 0; b < 50; ++b)
+            runBlock(filter, out, t);
+
+        // a copy carrying on with the old model, and a new one starting at the switch
+        auto oldModel = filter;
+        auto k35 = sfpp::ModelConfig{sfpp::Passband::LP, sfpp::DriveMode::K35_Mild};
+        auto newModel = sfpp::Filter();
+        configure(newModel, sfpp::FilterModel::K35, k35);
+        REQUIRE(newModel.prepareInstance());
+
+        configure(filter, sfpp::FilterModel::K35, k35);
+        REQUIRE(filter.prepareInstanceWithCrossfade(64));
+        REQUIRE(filter.isCrossfading());
+
+        auto tOld{t}, tNew{t};
+        runBlock(filter, out, t);
+        runBlock(oldModel, ref, tOld);
+        REQUIRE(out[0] == Approx(ref[0]).margin(1e-6));
+        runBlock(newModel, ref, tNew);
+
+        for (int b = 1; b < 4; ++b)
+        {
+            runBlock(filter, out, t);
+            runBlock(newModel, ref, tNew);
+        }
+        REQUIRE(!filter.isCrossfading());
+
+        // once the fade is done the new model is exactly as if it had been there all along
+        for (int b = 0; b < 10; ++b)
+        {
+            runBlock(filter, out, t);
+            runBlock(newModel, ref, tNew);
+            for (int s = 0; s < 16; ++s)
+                REQUIRE(out[s] == ref[s]);
+        }
+    }
+
+    SECTION("Is Smoother Than A Reset")
+    {
+        auto maxJumpAcrossSwitch = [&](bool crossfade) {
+            auto filter = sfpp::Filter();
+            configure(filter, sfpp::FilterModel::OBXD_4Pole,
+                      {sfpp::Passband::LP, sfpp::Slope::Slope_24dB});
+            REQUIRE(filter.prepareInstance());
+
+            int t{0};
+            float out[16];
+            for (int b = 0; b < 50; ++b)
+                runBlock(filter, out, t);
+            auto last = out[15];
+
+            configure(filter, sfpp::FilterModel::CytomicSVF, {sfpp::Passband::HP});
+            if (crossfade)
+                REQUIRE(filter.prepareInstanceWithCrossfade(128));
+            else
+                REQUIRE(filter.prepareInstance());
+
+            float jump{0};
+            for (int b = 0; b < 8; ++b)
+            {
+                runBlock(filter, out, t);
+                for (int s = 0; s < 16; ++s)
+                {
+                    jump = std::max(jump, std::fabs(out[s] - last));
+                    last = out[s];
+                }
+            }
+            return jump;
+        };
+
+        REQUIRE(maxJumpAcrossSwitch(true) < 0.5f * maxJumpAcrossSwitch(false));
+    }
+
+    SECTION("Models Sharing Delay Lines Hand Over Directly")
+    {
+        auto sz = sfpp::Filter::requiredDelayLinesSizes(sfpp::FilterModel::Comb,
+                                                        {sfpp::Slope::Comb_Positive_100});
+        std::vector<float> lines(sz * 4);
+
+        auto filter = sfpp::Filter();
+        configure(filter, sfpp::FilterModel::Comb, {sfpp::Slope::Comb_Positive_100});
+        filter.provideAllDelayLines(lines.data());
+        REQUIRE(filter.prepareInstance());
+
+        configure(filter, sfpp::FilterModel::Comb, {sfpp::Slope::Comb_Negative_100});
+        REQUIRE(filter.prepareInstanceWithCrossfade(64));
+        REQUIRE(!filter.isCrossfading());
+    }
+
+    SECTION("Without A Crossfade State The Change Is Immediate")
+    {
+        auto filter = sfpp::Filter();
+        configure(filter, sfpp::FilterModel::VemberClassic,
+                  {sfpp::Passband::LP, sfpp::Slope::Slope_12dB, sfpp::DriveMode::Standard});
+        REQUIRE(filter.prepareInstance());
+
+        configure(filter, sfpp::FilterModel::CytomicSVF, {sfpp::Passband::HP});
+        filter.provideCrossfadeState(nullptr);
+        REQUIRE(filter.prepareInstanceWithCrossfade(64));
+        REQUIRE(!filter.isCrossfading());
+    }
+}